@@ -0,0 +1,182 @@
+#include "assetpack.h"
+#include <cstring>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+const std::string AssetPack::rootPath = "../../";
+const std::string AssetPack::packPath = "assets.pak";
+
+/**
+ * Private constructor of the AssetPack, maps the pack file into memory.
+ * @param path Path of the pack file.
+ */
+AssetPack::AssetPack(const std::string& path) : base(nullptr), length(0) {
+#ifdef _WIN32
+    fileHandle = nullptr;
+    mappingHandle = nullptr;
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        std::cerr << "Asset pack " << path << " not found, loading loose files" << std::endl;
+        return;
+    }
+    LARGE_INTEGER fileSize;
+    HANDLE mapping = nullptr;
+    if (GetFileSizeEx(file, &fileSize) && fileSize.QuadPart > 0) {
+        mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    }
+    if (mapping == nullptr) {
+        CloseHandle(file);
+        std::cerr << "Failed to map asset pack " << path << std::endl;
+        return;
+    }
+    fileHandle = file;
+    mappingHandle = mapping;
+    base = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+    length = static_cast<std::size_t>(fileSize.QuadPart);
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        std::cerr << "Asset pack " << path << " not found, loading loose files" << std::endl;
+        return;
+    }
+    struct stat info{};
+    if (fstat(fd, &info) == 0 && info.st_size > 0) {
+        void* mapped = mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapped != MAP_FAILED) {
+            base = static_cast<const char*>(mapped);
+            length = static_cast<std::size_t>(info.st_size);
+            madvise(mapped, length, MADV_WILLNEED);   // start reading the pack ahead of the first load
+        }
+    }
+    ::close(fd);    // the mapping keeps the file contents alive
+#endif
+    if (base == nullptr) {
+        std::cerr << "Failed to map asset pack " << path << std::endl;
+        close();
+        return;
+    }
+    if (!readIndex()) {
+        std::cerr << "Asset pack " << path << " is invalid, loading loose files" << std::endl;
+        close();
+    }
+}
+
+/**
+ * Destructor of the AssetPack.
+ */
+AssetPack::~AssetPack() {
+    close();
+}
+
+/**
+ * Return the pack shared by the whole process.
+ * @return Reference to the asset pack.
+ */
+AssetPack& AssetPack::getInstance() {
+    static AssetPack instance(packPath);
+    return instance;
+}
+
+/**
+ * Check if the pack file was found and mapped.
+ * @return True if assets are served from the pack, false otherwise.
+ */
+bool AssetPack::isOpen() const {
+    return base != nullptr;
+}
+
+/**
+ * Look up the bytes of an asset inside the mapped pack.
+ * @param id The asset id.
+ * @param data Set to the start of the asset if found.
+ * @param size Set to the size of the asset if found.
+ * @return True if the pack contains the asset, false otherwise.
+ */
+bool AssetPack::find(const std::string& id, const void*& data, std::size_t& size) const {
+    auto it = entries.find(id);
+    if (it == entries.end()) {
+        return false;
+    }
+    data = base + it->second->offset;
+    size = static_cast<std::size_t>(it->second->size);
+    return true;
+}
+
+/**
+ * Get the path of an asset as a loose file.
+ * @param id The asset id.
+ * @return The path of the loose file relative to the working directory.
+ */
+std::string AssetPack::getLoosePath(const std::string& id) {
+    return rootPath + id;
+}
+
+/**
+ * Get the path of the file an asset is read from.
+ * @param id The asset id.
+ * @return The path of the pack file if it contains the asset, otherwise the path of the loose file.
+ */
+std::string AssetPack::getSourcePath(const std::string& id) const {
+    return entries.count(id) ? packPath : getLoosePath(id);
+}
+
+/**
+ * Validate the header and build the lookup table from the index.
+ * @return True if the mapped file is a valid pack, false otherwise.
+ */
+bool AssetPack::readIndex() {
+    if (length < sizeof(PackHeader)) {
+        return false;
+    }
+    const auto* header = reinterpret_cast<const PackHeader*>(base);
+    if (std::memcmp(header->magic, magic, sizeof(magic)) != 0 || header->version != version) {
+        return false;
+    }
+    std::size_t indexEnd = sizeof(PackHeader) + static_cast<std::size_t>(header->entryCount) * sizeof(PackEntry);
+    if (indexEnd > length) {
+        return false;
+    }
+    const auto* index = reinterpret_cast<const PackEntry*>(base + sizeof(PackHeader));
+    for (std::uint32_t i = 0; i < header->entryCount; ++i) {
+        const PackEntry& entry = index[i];
+        if (entry.offset > length || entry.size > length - entry.offset ||
+            std::memchr(entry.name, '\0', sizeof(entry.name)) == nullptr) {
+            return false;
+        }
+        entries[entry.name] = &entry;
+    }
+    return true;
+}
+
+/**
+ * Unmap the pack file and clear the lookup table.
+ */
+void AssetPack::close() {
+    entries.clear();
+#ifdef _WIN32
+    if (base != nullptr) {
+        UnmapViewOfFile(base);
+    }
+    if (mappingHandle != nullptr) {
+        CloseHandle(mappingHandle);
+    }
+    if (fileHandle != nullptr) {
+        CloseHandle(fileHandle);
+    }
+    mappingHandle = nullptr;
+    fileHandle = nullptr;
+#else
+    if (base != nullptr) {
+        munmap(const_cast<char*>(base), length);
+    }
+#endif
+    base = nullptr;
+    length = 0;
+}
@@ -0,0 +1,160 @@
+/**
+ * @file assetpack.h
+ * @brief Declaration of the AssetPack class and the asset pack file format.
+ */
+
+#ifndef FIRE_FIGHTER_ASSETPACK_H
+#define FIRE_FIGHTER_ASSETPACK_H
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <map>
+#include <string>
+
+/**
+ * @brief Header at the start of an asset pack file.
+ *
+ * The header is followed by entryCount PackEntry records, followed by the asset contents.
+ * Every asset starts at an offset that is a multiple of alignment. All integers are stored in native
+ * byte order, the pack is built by the AssetPacker step of the same build that reads it.
+ */
+struct PackHeader {
+    char magic[4]; ///< Always "FFPK".
+    std::uint32_t version; ///< Format version, currently 1.
+    std::uint32_t entryCount; ///< Number of PackEntry records following the header.
+    std::uint32_t alignment; ///< Alignment of every asset blob in bytes.
+};
+
+/**
+ * @brief Index record describing one asset inside an asset pack file.
+ */
+struct PackEntry {
+    char name[64]; ///< Zero terminated asset id (path relative to the project root).
+    std::uint64_t offset; ///< Offset of the asset from the start of the file.
+    std::uint64_t size; ///< Size of the asset in bytes.
+};
+
+/**
+ * @class AssetPack
+ * @brief Read-only view of the asset pack produced by the AssetPacker build step.
+ *
+ * The pack file is opened once and mapped into memory, so every asset is read straight out of the
+ * page cache and handed to SFML through loadFromMemory. When the pack is missing, for example when
+ * running from an IDE without the build step, assets are loaded from the loose files instead.
+ */
+class AssetPack {
+public:
+    static constexpr char magic[4] = {'F', 'F', 'P', 'K'}; ///< Magic bytes at the start of every pack file.
+    static constexpr std::uint32_t version = 1; ///< Format version written and understood.
+    static constexpr std::uint32_t alignment = 64; ///< Alignment of asset blobs written by the packer.
+
+    /**
+     * @brief Returns the pack shared by the whole process, mapping it on first use.
+     * @return Reference to the asset pack.
+     */
+    static AssetPack& getInstance();
+
+    /**
+     * @brief Destructor, unmaps the pack file.
+     */
+    ~AssetPack();
+
+    /**
+     * @brief Checks if the pack file was found and mapped.
+     * @return True if assets are served from the pack, false if loose files are used.
+     */
+    bool isOpen() const;
+
+    /**
+     * @brief Looks up the bytes of an asset inside the mapped pack.
+     * @param id The asset id (path relative to the project root).
+     * @param data Set to the start of the asset if found.
+     * @param size Set to the size of the asset if found.
+     * @return True if the pack contains the asset, false otherwise.
+     */
+    bool find(const std::string& id, const void*& data, std::size_t& size) const;
+
+    /**
+     * @brief Loads an SFML resource (image, texture, font or sound buffer) from the pack.
+     *
+     * Falls back to the loose file when the asset is not in the pack. The mapped bytes stay valid
+     * for the life of the process, so resources that keep reading their source (fonts) are safe.
+     *
+     * @param id The asset id (path relative to the project root).
+     * @param resource The resource to load.
+     * @return True if the resource was loaded, false otherwise.
+     */
+    template <typename Resource>
+    bool load(const std::string& id, Resource& resource) const {
+        const void* data;
+        std::size_t size;
+        if (find(id, data, size)) {
+            return resource.loadFromMemory(data, size);
+        }
+        return resource.loadFromFile(rootPath + id);
+    }
+
+    /**
+     * @brief Opens an SFML music stream from the pack, falling back to the loose file.
+     * @param id The asset id (path relative to the project root).
+     * @param music The music to open.
+     * @return True if the music was opened, false otherwise.
+     */
+    template <typename Music>
+    bool open(const std::string& id, Music& music) const {
+        const void* data;
+        std::size_t size;
+        if (find(id, data, size)) {
+            return music.openFromMemory(data, size);
+        }
+        return music.openFromFile(rootPath + id);
+    }
+
+    /**
+     * @brief Gets the path of an asset as a loose file.
+     * @param id The asset id (path relative to the project root).
+     * @return The path of the loose file relative to the working directory.
+     */
+    static std::string getLoosePath(const std::string& id);
+
+    /**
+     * @brief Gets the path of the file an asset is read from.
+     * @param id The asset id (path relative to the project root).
+     * @return The path of the pack file if it contains the asset, otherwise the path of the loose file.
+     */
+    std::string getSourcePath(const std::string& id) const;
+
+private:
+    /**
+     * @brief Private constructor, maps the pack file if it exists.
+     * @param path Path of the pack file.
+     */
+    explicit AssetPack(const std::string& path);
+
+    AssetPack(const AssetPack&) = delete;
+    AssetPack& operator=(const AssetPack&) = delete;
+
+    /**
+     * @brief Validates the header and builds the lookup table from the index.
+     * @return True if the mapped file is a valid pack, false otherwise.
+     */
+    bool readIndex();
+
+    /**
+     * @brief Unmaps the pack file and clears the lookup table.
+     */
+    void close();
+
+    const char* base; ///< Start of the mapped file.
+    std::size_t length; ///< Size of the mapped file.
+    std::map<std::string, const PackEntry*> entries; ///< Index records by asset id.
+#ifdef _WIN32
+    void* fileHandle; ///< Handle of the open pack file.
+    void* mappingHandle; ///< Handle of the file mapping.
+#endif
+    static const std::string rootPath; ///< Path from the working directory to the project root.
+    static const std::string packPath; ///< Path of the pack file relative to the working directory.
+};
+
+#endif //FIRE_FIGHTER_ASSETPACK_H
@@ -4,32 +4,15 @@
  * Constructor of a Barrier object.
  * @param gameSettings The game settings that are set by the user.
  */
-Barrier::Barrier(Settings gameSettings) {
+Barrier::Barrier(Settings gameSettings) : gameSettings(gameSettings) {
     // Set default size
     size = 1.0f;
 
-    // Load barrier texture
-    if (!iceBlockTexture.loadFromFile("../../resource/img/iceBlock.png")) {
-        std::cerr << "Failed to load background image!" << std::endl;
-    }
-
-    // Load shrink sound buffer
-    if (!shrinkBuffer.loadFromFile("../../resource/sounds/melt.mp3")) {
-        std::cerr << "Shrink sound could not be loaded" << std::endl;
-    }
-
-    // Set the sound buffer for the shrink sound
-    shrinkSound.setBuffer(shrinkBuffer);
+    // Acquire the shared barrier atlas region and set it for the barrier sprite
+    reloadTexture();
 
-    // Set texture for the barrier sprite
-    iceBlockSprite.setTexture(iceBlockTexture);
-
-    // Scale the bullet sprite based on resolution from game settings
-    if(gameSettings.getVector().x == 3840){
-        iceBlockSprite.setScale(gameSettings.widthScaling(0.75), gameSettings.heightScaling(0.75));
-    }else{
-        iceBlockSprite.setScale(gameSettings.widthScaling(1.5), gameSettings.heightScaling(1.5));
-    }
+    // Register the shrink sound, decoded once and shared by every barrier
+    shrinkSound = SoundManager::getInstance().load("resource/sounds/melt.mp3", 3);
 }
 
 /**
@@ -62,7 +45,7 @@ void Barrier::shrink() {
     // Check if sound effect is enabled in the game settings
     if (gameSettings.toggleSounds()) {
         // Play the shrink sound effect
-        shrinkSound.play();
+        SoundManager::getInstance().play(shrinkSound);
     }
 
     // Apply the scaling factor to the size
@@ -73,12 +56,8 @@ void Barrier::shrink() {
         size = 0.f;  // barrier disappears
     }
 
-    // Resize the barrier bulletSprite
-    if(gameSettings.getVector().x == 3840){
-        iceBlockSprite.setScale(gameSettings.widthScaling(0.75)* size, gameSettings.heightScaling(0.75)* size);
-    }else{
-        iceBlockSprite.setScale(gameSettings.widthScaling(1.5)* size, gameSettings.heightScaling(1.5)* size);
-    }
+    // Resize the barrier bulletSprite, on top of the scale of its atlas region
+    iceBlockSprite.setScale(size * iceBlockTexture.scale, size * iceBlockTexture.scale);
 }
 
 /**
@@ -88,18 +67,31 @@ void Barrier::reset() {
     // Set default size
     size = 1.0f;
 
-    // Scale the bullet sprite based on resolution from game settings
-    if(gameSettings.getVector().x == 3840){
-        iceBlockSprite.setScale(gameSettings.widthScaling(0.75), gameSettings.heightScaling(0.75));
-    }else{
-        iceBlockSprite.setScale(gameSettings.widthScaling(1.5), gameSettings.heightScaling(1.5));
-    }
+    // Restore the full size of the barrier sprite
+    iceBlockSprite.setScale(iceBlockTexture.scale, iceBlockTexture.scale);
+}
+
+/**
+ * Acquire the barrier atlas region again for the current pixel density of the virtual view.
+ */
+void Barrier::reloadTexture() {
+    iceBlockTexture = TextureCache::getInstance().acquireRegion("resource/img/iceBlock.png", VirtualView::getResolution());
+    iceBlockTexture.apply(iceBlockSprite);
+    iceBlockSprite.setScale(size * iceBlockTexture.scale, size * iceBlockTexture.scale);
 }
 
 /**
  * Draw the Barrier object.
- * @param window The SFML render window on which to draw the Barrier.
+ * @param window The render target on which to draw the Barrier.
  */
-void Barrier::draw(sf::RenderWindow& window) {
+void Barrier::draw(sf::RenderTarget& window) {
     window.draw(iceBlockSprite);
 }
+
+/**
+ * Add the Barrier object to a batch of sprites.
+ * @param batch The batch collecting the sprites of the frame.
+ */
+void Barrier::addTo(SpriteBatch& batch) const {
+    batch.add(iceBlockSprite);
+}
@@ -12,6 +12,10 @@
 #include <iostream>
 #include "bullet.h"
 #include "settings.h"
+#include "texturecache.h"
+#include "virtualview.h"
+#include "soundmanager.h"
+#include "spritebatch.h"
 
 /**
  * @class Barrier
@@ -78,22 +82,35 @@ public:
      */
     void reset();
 
+    /**
+     * @brief Acquires the barrier texture again for the current pixel density of the virtual view.
+     *
+     * The barrier keeps its current size.
+     */
+    void reloadTexture();
+
     /**
      * @brief Draws the Barrier object.
      *
      * This function draws the Barrier object on the specified SFML render window.
      *
-     * @param window The SFML render window on which to draw the Barrier.
+     * @param window The render target on which to draw the Barrier.
+     */
+    void draw(sf::RenderTarget& window);
+
+    /**
+     * @brief Adds the Barrier object to a batch of sprites.
+     *
+     * @param batch The batch collecting the sprites of the frame.
      */
-    void draw(sf::RenderWindow& window);
+    void addTo(SpriteBatch& batch) const;
 
 private:
     Settings gameSettings; /**< The settings object used for game configuration.*/
-    sf::Texture iceBlockTexture; /**< The texture for the ice block barrier.*/
+    TextureRegion iceBlockTexture; /**< Shared atlas region for the ice block barrier.*/
     sf::Sprite iceBlockSprite; /**< The sprite representing the ice block barrier.*/
     float size; /**< The size of the barrier.*/
-    sf::SoundBuffer shrinkBuffer; /**< The sound buffer for the shrink effect.*/
-    sf::Sound shrinkSound; /**< The sound object for the shrink effect.*/
+    int shrinkSound; /**< Handle of the shrink effect in the SoundManager.*/
 
 };
 
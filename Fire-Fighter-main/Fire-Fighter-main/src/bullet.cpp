@@ -5,28 +5,15 @@
  * @param startX The starting x-coordinate of the bullet.
  * @param startY The starting y-coordinate of the bullet.
  * @param type The type of bullet ("player" or "enemy").
- * @param res The resolution of the game window.
+ * @param res The resolution the bullet sprite is sized for, the size of the virtual space in window pixels.
  */
 Bullet::Bullet(float startX, float startY, const std::string& type, sf::Vector2u res) {
-    // Load and set texture based on bullet type
-    loadTexture(type);
-    bulletSprite.setTexture(bulletTexture);
+    // Acquire and set the texture sized for the bullet type and game resolution
+    loadTexture(type, res);
 
     // Set initial position
     bulletSprite.setPosition(startX, startY);
 
-    // Set scale based on bullet type and game resolution
-    if (type == "enemy"){
-        bulletSprite.setScale(0.5f * ((float)res.x/1280.f), 0.5f * ((float)res.y/720.f));
-    }
-    else{
-        if(res.x == 3840){
-            bulletSprite.setScale(0.5f * ((float)res.x/1280.f), 0.5f * ((float)res.y/720.f));
-        }else{
-            bulletSprite.setScale(1.2f * ((float)res.x/1280.f), 1.2f * ((float)res.y/720.f));
-        }
-    }
-
     // Set default speed
     speed = 300.f;
 }
@@ -50,19 +37,6 @@ void Bullet::update(const sf::Time& delta, const std::string& type) {
     }
 }
 
-/**
- * Draw the bullet sprite.
- * @param window The SFML render window to draw the bullet on.
- * @param type The type of bullet ("player" or "enemy").
- */
-void Bullet::draw(sf::RenderWindow& window, const std::string &type) {
-    // Load texture based on bullet type
-    loadTexture(type);
-
-    // Draw bullet sprite on the render window
-    window.draw(bulletSprite);
-}
-
 /**
  * Return the global bounding rectangle of the bullet sprite.
  * @return The global bounding rectangle of the bullet sprite.
@@ -80,18 +54,35 @@ const sf::Sprite& Bullet::getSprite() const {
 }
 
 /**
- * Load the texture of the bullet.
+ * Record the position of the bullet at the start of a simulation tick.
+ */
+void Bullet::recordPosition() {
+    motion.record(bulletSprite);
+}
+
+/**
+ * Return the bullet sprite placed between the last two simulation ticks.
+ * @param alpha How far the frame is between the last tick and the next one, from 0 to 1.
+ * @return The sprite to draw.
+ */
+sf::Sprite Bullet::getInterpolatedSprite(float alpha) const {
+    return motion.interpolate(bulletSprite, alpha);
+}
+
+/**
+ * Acquire the texture of the bullet from the texture cache.
  * @param type The type of bullet ("player" or "enemy").
+ * @param res The resolution the bullet sprite is sized for, the size of the virtual space in window pixels.
  */
-void Bullet::loadTexture(const std::string &type) {
-    // Load file based on the type and print error message if fails
-    if (type =="player" && !bulletTexture.loadFromFile("../../resource/img/droplet.png")) {
-        std::cerr << "Failed to load player's bullet texture" << std::endl;
+void Bullet::loadTexture(const std::string &type, sf::Vector2u res) {
+    // Pick the shared texture based on the type
+    if (type == "player") {
+        bulletTexture = TextureCache::getInstance().acquireRegion("resource/img/droplet.png", res);
     }
-    else if(type =="enemy" && !bulletTexture.loadFromFile("../../resource/img/fireball.png")) {
-        std::cerr << "Failed to load enemy's bullet texture" << std::endl;
+    else {
+        bulletTexture = TextureCache::getInstance().acquireRegion("resource/img/fireball.png", res);
     }
 
-    // Set the loaded texture to the bullet sprite
-    bulletSprite.setTexture(bulletTexture);
+    // Set the cached atlas region to the bullet sprite
+    bulletTexture.apply(bulletSprite);
 }
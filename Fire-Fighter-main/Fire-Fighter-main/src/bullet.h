@@ -9,6 +9,9 @@
 
 #include <SFML/Graphics.hpp>
 #include <iostream>
+#include <memory>
+#include "texturecache.h"
+#include "interpolator.h"
 
 /**
  * @class Bullet
@@ -24,13 +27,13 @@ public:
      * @brief Constructs a Bullet object with specified parameters.
      *
      * This constructor initializes a Bullet object with the given starting position, type, and game resolution.
-     * It loads the appropriate texture for the bullet based on its type and sets its initial position and scale.
+     * It loads the appropriate texture for the bullet based on its type and resolution and sets its initial position.
      * The speed of the bullet is set to a default value of 300 units per second.
      *
      * @param startX The starting x-coordinate of the bullet.
      * @param startY The starting y-coordinate of the bullet.
      * @param type The type of bullet ("player" or "enemy").
-     * @param res The resolution of the game window.
+     * @param res The resolution the bullet sprite is sized for, the size of the virtual space in window pixels.
      */
     Bullet(float startX, float startY, const std::string &type, sf::Vector2u res);
 
@@ -51,18 +54,6 @@ public:
      */
     void update(const sf::Time& delta, const std::string &type);
 
-    /**
-     * @brief Draws the bullet sprite on the specified render window.
-     *
-     * This function draws the bullet sprite on the provided SFML render window.
-     * It first loads the appropriate texture for the bullet based on its type,
-     * then draws the bullet sprite onto the render window.
-     *
-     * @param window The SFML render window to draw the bullet on.
-     * @param type The type of bullet ("player" or "enemy").
-     */
-    void draw(sf::RenderWindow& window, const std::string &type);
-
     /**
     * @brief Returns the global bounding rectangle of the bullet sprite.
     *
@@ -82,21 +73,36 @@ public:
      */
     const sf::Sprite& getSprite() const;
 
+    /**
+     * @brief Records the position of the bullet at the start of a simulation tick.
+     */
+    void recordPosition();
+
+    /**
+     * @brief Returns the bullet sprite placed between the last two simulation ticks.
+     * @param alpha How far the frame is between the last tick and the next one, from 0 to 1.
+     * @return The sprite to draw.
+     */
+    sf::Sprite getInterpolatedSprite(float alpha) const;
+
 private:
     sf::Sprite bulletSprite; /**< The sprite representing the bullet. */
-    sf::Texture bulletTexture; /**< The texture of the bullet sprite. */
+    TextureRegion bulletTexture; /**< Shared atlas region of the bullet sprite. */
     float speed; /**< The speed of the bullet. */
+    Interpolator motion; /**< Position of the bullet at the previous simulation tick. */
 
     /**
-     * @brief Loads the appropriate texture for the bullet based on its type.
+     * @brief Acquires the appropriate texture for the bullet based on its type.
      *
-     * This function loads the appropriate texture for the bullet sprite based on its type.
-     * If the type is "player", it loads the droplet texture. If the type is "enemy",
-     * it loads the fireball texture. If the texture loading fails, an error message is printed.
+     * This function takes the texture for the bullet sprite from the TextureCache based on its type.
+     * If the type is "player", it uses the droplet texture. If the type is "enemy",
+     * it uses the fireball texture. Each texture is only decoded once per process and comes
+     * pre-sized for the resolution, so the sprite is drawn unscaled.
      *
      * @param type The type of bullet ("player" or "enemy").
+     * @param res The resolution the bullet sprite is sized for, the size of the virtual space in window pixels.
      */
-    void loadTexture(const std::string& type);
+    void loadTexture(const std::string& type, sf::Vector2u res);
 };
 
 #endif //FIRE_FIGHTER_BULLET_H
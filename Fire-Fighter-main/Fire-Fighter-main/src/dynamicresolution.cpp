@@ -0,0 +1,146 @@
+#include "dynamicresolution.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+const float DynamicResolution::scaleStep = 0.1f;
+const float DynamicResolution::smoothing = 0.1f;
+const float DynamicResolution::slowFactor = 1.15f;
+const float DynamicResolution::onTargetFactor = 1.05f;
+const sf::Time DynamicResolution::settleDelay = sf::seconds(0.5f);
+const sf::Time DynamicResolution::probeDelay = sf::seconds(3.f);
+
+/**
+ * Construct a scaler, create() must be called before it renders offscreen.
+ * @param minScale Smallest fraction of the window size the scene is rendered at.
+ * @param maxScale Largest fraction of the window size the scene is rendered at.
+ */
+DynamicResolution::DynamicResolution(float minScale, float maxScale)
+        : enabled(false), minScale(minScale), maxScale(maxScale), scale(maxScale),
+          targetFrameTime(sf::seconds(1.f / 60.f)), averageFrameTime(1.f / 60.f) {}
+
+/**
+ * Allocate the offscreen texture for a window size.
+ * @param windowSize Size of the window the scene is presented to.
+ * @return True on success, false if render textures are not available.
+ */
+bool DynamicResolution::create(const sf::Vector2u& windowSize) {
+    this->windowSize = windowSize;
+    unsigned width = static_cast<unsigned>(std::ceil(windowSize.x * maxScale));
+    unsigned height = static_cast<unsigned>(std::ceil(windowSize.y * maxScale));
+    enabled = layer.create(width, height);
+    if (!enabled) {
+        std::cerr << "Failed to create the scene layer, drawing the scene at native resolution" << std::endl;
+        return false;
+    }
+    layer.setSmooth(true);  // filter when stretching the scene back up
+    scale = maxScale;
+    averageFrameTime = targetFrameTime.asSeconds();
+    settleTime = sf::Time::Zero;
+    onTargetTime = sf::Time::Zero;
+    return true;
+}
+
+/**
+ * Set the frame time the scale is adjusted to hold.
+ * @param frameTime The target frame time.
+ */
+void DynamicResolution::setTargetFrameTime(sf::Time frameTime) {
+    targetFrameTime = frameTime;
+    averageFrameTime = frameTime.asSeconds();
+}
+
+/**
+ * Adjust the scale to the time the last frame took.
+ * @param frameTime Duration of the last frame.
+ */
+void DynamicResolution::update(sf::Time frameTime) {
+    float target = targetFrameTime.asSeconds();
+    // A single hitch, like the stage banner or a window move, should not drop the resolution
+    float sample = std::min(frameTime.asSeconds(), target * 2.f);
+    averageFrameTime += (sample - averageFrameTime) * smoothing;
+
+    settleTime += frameTime;
+    if (settleTime < settleDelay) {
+        return;
+    }
+
+    if (averageFrameTime > target * slowFactor) {
+        onTargetTime = sf::Time::Zero;
+        if (scale > minScale) {
+            scale = std::max(minScale, scale - scaleStep);
+            settleTime = sf::Time::Zero;
+        }
+    } else if (averageFrameTime < target * onTargetFactor) {
+        // The frame limiter hides any headroom, so step up now and then and see if it holds
+        onTargetTime += frameTime;
+        if (onTargetTime >= probeDelay && scale < maxScale) {
+            scale = std::min(maxScale, scale + scaleStep);
+            settleTime = sf::Time::Zero;
+            onTargetTime = sf::Time::Zero;
+        }
+    } else {
+        onTargetTime = sf::Time::Zero;
+    }
+}
+
+/**
+ * Start drawing the scene.
+ * @param window The window the scene is presented to.
+ * @return The target to draw the scene to.
+ */
+sf::RenderTarget& DynamicResolution::begin(sf::RenderTarget& window) {
+    if (!enabled) {
+        return window;
+    }
+    // Same view as the window, but mapped onto the scaled region in the corner of the layer
+    sf::Vector2u scaled = getScaledSize();
+    float fx = static_cast<float>(scaled.x) / layer.getSize().x;
+    float fy = static_cast<float>(scaled.y) / layer.getSize().y;
+    sf::View view = window.getView();
+    sf::FloatRect viewport = view.getViewport();
+    view.setViewport(sf::FloatRect(viewport.left * fx, viewport.top * fy, viewport.width * fx, viewport.height * fy));
+    layer.setView(view);
+    layer.clear();
+    return layer;
+}
+
+/**
+ * Stretch the scene drawn since begin() over the window.
+ * @param window The window the scene is presented to.
+ */
+void DynamicResolution::present(sf::RenderTarget& window) {
+    if (!enabled) {
+        return;
+    }
+    layer.display();
+
+    sf::Vector2u scaled = getScaledSize();
+    layerSprite.setTexture(layer.getTexture());
+    layerSprite.setTextureRect(sf::IntRect(0, 0, static_cast<int>(scaled.x), static_cast<int>(scaled.y)));
+    layerSprite.setScale(static_cast<float>(window.getSize().x) / scaled.x, static_cast<float>(window.getSize().y) / scaled.y);
+
+    // The layer is opaque, so it is copied over the window without blending, in window pixels
+    sf::View view = window.getView();
+    window.setView(sf::View(sf::FloatRect(0.f, 0.f, window.getSize().x, window.getSize().y)));
+    window.draw(layerSprite, sf::BlendNone);
+    window.setView(view);
+}
+
+/**
+ * Get the current scale of the internal resolution.
+ * @return The fraction of the window size the scene is rendered at.
+ */
+float DynamicResolution::getScale() const {
+    return enabled ? scale : 1.f;
+}
+
+/**
+ * Get the size in pixels of the region the scene is rendered to at the current scale.
+ * @return The size of the scaled region.
+ */
+sf::Vector2u DynamicResolution::getScaledSize() const {
+    unsigned width = std::max(1u, static_cast<unsigned>(std::lround(windowSize.x * scale)));
+    unsigned height = std::max(1u, static_cast<unsigned>(std::lround(windowSize.y * scale)));
+    return sf::Vector2u(std::min(width, layer.getSize().x), std::min(height, layer.getSize().y));
+}
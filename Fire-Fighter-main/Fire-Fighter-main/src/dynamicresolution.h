@@ -0,0 +1,103 @@
+/**
+ * @file dynamicresolution.h
+ * @brief Declaration of the DynamicResolution class.
+ */
+
+#ifndef FIRE_FIGHTER_DYNAMICRESOLUTION_H
+#define FIRE_FIGHTER_DYNAMICRESOLUTION_H
+
+#include <SFML/Graphics.hpp>
+
+/**
+ * @class DynamicResolution
+ * @brief Renders a scene at a reduced internal resolution that follows the frame time.
+ *
+ * On software OpenGL the cost of a frame grows with the number of pixels filled, so at high
+ * window resolutions the gameplay scene cannot hold the target frame rate. The scene is drawn into
+ * an offscreen texture instead, at a scale of the window size between a minimum and a maximum,
+ * and then stretched over the window. When frames take longer than the target the scale steps
+ * down; once frames have been on time for a while it steps back up to probe for headroom.
+ *
+ * The texture is allocated once at the maximum scale and the scene is drawn into its top-left
+ * corner through the view's viewport, so changing the scale never reallocates.
+ *
+ * Anything drawn to the window after present(), such as the HUD, stays at native resolution.
+ */
+class DynamicResolution {
+public:
+    /**
+     * @brief Constructs a scaler, create() must be called before it renders offscreen.
+     * @param minScale Smallest fraction of the window size the scene is rendered at.
+     * @param maxScale Largest fraction of the window size the scene is rendered at.
+     */
+    explicit DynamicResolution(float minScale = 0.5f, float maxScale = 1.f);
+
+    /**
+     * @brief Allocates the offscreen texture for a window size.
+     * @param windowSize Size of the window the scene is presented to.
+     * @return True on success, false if render textures are not available, the scene is then drawn directly.
+     */
+    bool create(const sf::Vector2u& windowSize);
+
+    /**
+     * @brief Sets the frame time the scale is adjusted to hold.
+     * @param frameTime The target frame time.
+     */
+    void setTargetFrameTime(sf::Time frameTime);
+
+    /**
+     * @brief Adjusts the scale to the time the last frame took.
+     * @param frameTime Duration of the last frame.
+     */
+    void update(sf::Time frameTime);
+
+    /**
+     * @brief Starts drawing the scene.
+     *
+     * Clears the offscreen texture and gives it the view of the window, shrunk to the current scale.
+     *
+     * @param window The window the scene is presented to.
+     * @return The target to draw the scene to, the window itself if create() failed.
+     */
+    sf::RenderTarget& begin(sf::RenderTarget& window);
+
+    /**
+     * @brief Stretches the scene drawn since begin() over the window.
+     * @param window The window the scene is presented to.
+     */
+    void present(sf::RenderTarget& window);
+
+    /**
+     * @brief Gets the current scale of the internal resolution.
+     * @return The fraction of the window size the scene is rendered at.
+     */
+    float getScale() const;
+
+private:
+    /**
+     * @brief Gets the size in pixels of the region the scene is rendered to at the current scale.
+     * @return The size of the scaled region.
+     */
+    sf::Vector2u getScaledSize() const;
+
+    static const float scaleStep; ///< Change of the scale per adjustment.
+    static const float smoothing; ///< Weight of the newest frame in the average frame time.
+    static const float slowFactor; ///< The scale drops while the average is above the target times this factor.
+    static const float onTargetFactor; ///< Frames below the target times this factor count as on target.
+    static const sf::Time settleDelay; ///< Time after a change of the scale before it can change again.
+    static const sf::Time probeDelay; ///< Time on target before trying a higher scale.
+
+    sf::RenderTexture layer; ///< Offscreen texture the scene is rendered to.
+    sf::Sprite layerSprite; ///< Sprite stretching the scaled region of the layer over the window.
+    sf::Vector2u windowSize; ///< Size of the window the scene is presented to.
+    bool enabled; ///< Flag indicating whether the layer was created.
+    float minScale; ///< Smallest scale.
+    float maxScale; ///< Largest scale.
+    float scale; ///< Current scale.
+    sf::Time targetFrameTime; ///< Frame time the scale is adjusted to hold.
+    float averageFrameTime; ///< Smoothed frame time in seconds.
+    sf::Time settleTime; ///< Time since the scale last changed.
+    sf::Time onTargetTime; ///< Time the frames have been on target without interruption.
+};
+
+#endif //FIRE_FIGHTER_DYNAMICRESOLUTION_H
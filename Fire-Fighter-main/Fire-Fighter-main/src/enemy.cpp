@@ -15,17 +15,10 @@ int Enemy::totalDeath = 0;
  *
  * @param startX Initial X position.
  * @param startY Initial Y position.
- * @param screenWidth Width of the screen for calculating movement boundaries.
- * @param resolution Screen resolution for sprite scaling.
  */
-Enemy::Enemy(float startX, float startY, unsigned int screenWidth, const sf::Vector2u& resolution)
-        : movementSpeed(3.0f), screenWidth(screenWidth),isAlive(true) {
+Enemy::Enemy(float startX, float startY)
+        : movementSpeed(3.0f), isAlive(true) {
     setPosition(startX, startY);
-    res1.x = resolution.x;
-    res1.y = resolution.y;
-
-    sprite.setScale(1.f * ((float)resolution.x/1280.f), 1.f * ((float)resolution.y/720.f));
-    movementSpeed *= (1.0f * ((float)resolution.x/1280.f));
 }
 
 /**
@@ -47,7 +40,7 @@ void Enemy::kill() {
 void Enemy::update(const sf::Time& deltaTime) {
     float moveDistance = movementSpeed * deltaTime.asSeconds();
     sprite.move(moveDistance, 0);
-    if (sprite.getPosition().x > screenWidth) {
+    if (sprite.getPosition().x > VirtualView::getSize().x) {
         sprite.setPosition(-sprite.getGlobalBounds().width, sprite.getPosition().y);
     }
     // Update the position of enemy bullets
@@ -59,28 +52,34 @@ void Enemy::update(const sf::Time& deltaTime) {
 }
 
 /**
- * Draws the enemy and its bullets to the specified window.
+ * Adds the bullets of the enemy to a batch, so they are drawn together with every other bullet.
  *
- * @param window The SFML window to draw onto.
+ * @param batch The batch collecting the projectiles of the frame.
+ * @param alpha How far the frame is between the last simulation tick and the next one.
  */
-void Enemy::draw(sf::RenderWindow& window) {
-    if (isAlive) {
-        window.draw(sprite);
+void Enemy::addBulletsTo(SpriteBatch& batch, float alpha) const {
+    for (const auto& bullet : bullets) {
+        batch.add(bullet.getInterpolatedSprite(alpha));
     }
-    // Draw enemy bullets on the screen
+}
+
+/**
+ * Records the position of the enemy and its bullets before a simulation tick moves them.
+ */
+void Enemy::recordPositions() {
+    recordPosition();
     for (auto& bullet : bullets) {
-        bullet.draw(window, "enemy");
+        bullet.recordPosition();
     }
 }
 
 /**
- * Sets the texture of the enemy sprite from a given file path.
+ * Sets the texture of the enemy sprite from the shared texture cache.
  *
- * @param texturePath Path to the texture file.
+ * @param texturePath Asset id of the texture file.
  */
 void Enemy::setTexture(const std::string& texturePath) {
-    texture.loadFromFile(texturePath);
-    sprite.setTexture(texture);
+    Entity::setTexture(texturePath, VirtualView::getResolution());
 }
 
 /**
@@ -93,13 +92,13 @@ sf::FloatRect Enemy::getGlobalBounds() const {
 }
 
 /**
- * Gets the size of the enemy's texture.
+ * Gets the size of the enemy's sprite in the virtual space.
  *
  *
- * @return A sf::Vector2u representing the width and height of the texture.
+ * @return A sf::Vector2u representing the width and height of the sprite.
  */
 sf::Vector2u Enemy::getSize() const {
-    return texture.getSize();
+    return sf::Vector2u(sprite.getGlobalBounds().getSize());
 }
 
 /**
@@ -120,7 +119,7 @@ bool Enemy::getIsAlive() const {
  */
 void Enemy::shoot() {
     // Create a new bullet at the position of the enemy
-    Bullet enemyBullet(getPosition().x, getPosition().y, "enemy", res1);
+    Bullet enemyBullet(getPosition().x, getPosition().y, "enemy", VirtualView::getResolution());
     bullets.push_back(enemyBullet);
 }
 
@@ -158,7 +157,7 @@ void Enemy::increaseSpeed(float factor) {
  */
 void Enemy::removeBullet() {
     for (int i = bullets.size() - 1; i >= 0; --i) {
-        if (bullets[i].getGlobalBounds().getPosition().x > res1.x) {
+        if (bullets[i].getGlobalBounds().getPosition().x > VirtualView::getSize().x) {
             bullets.erase(bullets.begin() + i);
         }
     }
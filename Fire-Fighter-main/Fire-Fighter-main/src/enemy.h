@@ -17,23 +17,22 @@
 #include <iostream>
 #include "bullet.h"
 #include "entity.h"
+#include "spritebatch.h"
 
 
 class Enemy : public Entity {
 public:
 
     /**
-     * @brief Constructs an Enemy with initial position, screen width, and resolution.
+     * @brief Constructs an Enemy at an initial position.
      *
-     * Initializes the enemy's position, scales its sprite based on the resolution,
-     * and adjusts its movement speed accordingly.
+     * The enemy moves in the virtual space, so neither its speed nor its sprite depend on the
+     * resolution of the window.
      *
      * @param startX Initial X position of the enemy.
      * @param startY Initial Y position of the enemy.
-     * @param screenWidth Width of the game screen for boundary checks.
-     * @param resolution Current screen resolution for sprite scaling.
      */
-    Enemy(float startX, float startY, unsigned int screenWidth, const sf::Vector2u& resolution);
+    Enemy(float startX, float startY);
 
     /**
      * @brief Updates the enemy's position and handles bullet updates.
@@ -46,16 +45,22 @@ public:
     void update(const sf::Time& deltaTime);
 
     /**
-     * @brief Draws the enemy and its bullets to the specified render window.
+     * @brief Adds the bullets of the enemy to a batch of projectiles.
      *
-     * @param window Reference to the game window for drawing.
+     * @param batch The batch collecting the projectiles of the frame.
+     * @param alpha How far the frame is between the last simulation tick and the next one, from 0 to 1.
      */
-    void draw(sf::RenderWindow& window);
+    void addBulletsTo(SpriteBatch& batch, float alpha = 1.f) const;
 
     /**
-     * @brief Sets the texture of the enemy from a file path.
+     * @brief Records the position of the enemy and its bullets at the start of a simulation tick.
+     */
+    void recordPositions();
+
+    /**
+     * @brief Sets the texture of the enemy from the texture cache.
      *
-     * @param texturePath Path to the texture image file.
+     * @param texturePath Asset id of the texture image (path relative to the project root).
      */
     void setTexture(const std::string& texturePath);
 
@@ -119,10 +124,8 @@ public:
 private:
     std::vector<Bullet> bullets; ///< Vector holding bullets shot by the enemy.
     float movementSpeed; ///< Movement speed of the enemy.
-    unsigned int screenWidth; ///< Width of the screen for boundary checks.
     bool isAlive; ///< Flag indicating whether the enemy is alive.
     static int totalDeath; ///< Static counter for total enemy deaths.
-    sf::Vector2u res1; ///< Screen resolution for scaling purposes.
 };
 
 #endif // FIRE_FIGHTER_ENEMY_H
@@ -1,59 +1,33 @@
 #include "enemywave.h"
 
     /**
-     *Constructor: Initializes an enemy wave within the game environment, setting up initial positions, spacing,
-     *and creating enemies based on the game's window size, resolution, and UI metrics bar height.
-     * @param window
-     * @param resolution
+     *Constructor: Initializes an enemy wave within the virtual space of the game, setting up initial positions,
+     *spacing, and creating enemies below the UI metrics bar.
      * @param metricsBarHeight
      * @author Juyoung Lee, Sungmin Lee
      */
-EnemyWave::EnemyWave(sf::RenderWindow& window, const sf::Vector2u& resolution, float metricsBarHeight)
-        : window(window),
-          rows(5), columns(4), spacingX(100.0f), spacingY(70.0f),
+EnemyWave::EnemyWave(float metricsBarHeight)
+        : rows(5), columns(4), spacingX(100.0f), spacingY(70.0f),
           startX(0.0f),  startY(75.0f + metricsBarHeight) {
-    adjustSpacingForResolution(resolution); // Adjust spacing based on resolution
-    enemyGrid.resize(rows, std::vector<Enemy>(columns, Enemy(0, 0, window.getSize().x, resolution)));
+    enemyGrid.resize(rows, std::vector<Enemy>(columns, Enemy(0, 0)));
     for (int i = 0; i < rows; ++i) {
         for (int j = 0; j < columns; ++j) {
             float positionX = startX + j * spacingX;
             float positionY = startY + i * spacingY;
-            enemyGrid[i][j] = Enemy(positionX, positionY, window.getSize().x, resolution);
-            enemyGrid[i][j].setTexture("../../resource/img/fire.png");
+            enemyGrid[i][j] = Enemy(positionX, positionY);
+            enemyGrid[i][j].setTexture("resource/img/fire.png");
             totalSpawned++;
         }
     }
 }
 
-    /**
-    * Dynamically adjusts enemy spacing based on screen resolution.
-    *
-    * @param resolution The screen resolution to adapt enemy spacing for.
-    */
-void EnemyWave::adjustSpacingForResolution(const sf::Vector2u& resolution) {
-    if (resolution == sf::Vector2u(640, 360)) {
-        spacingX = 70.0f; // Smaller resolution, reduce spacing
-        spacingY = 40.0f;
-    } else if (resolution == sf::Vector2u(1280, 720)) {
-        spacingX = 100.0f; // Base resolution, base spacing
-        spacingY = 70.0f;
-    } else if (resolution == sf::Vector2u(1920, 1080)) {
-        spacingX = 130.0f; // Higher resolution, increase spacing
-        spacingY = 90.0f;
-    } else if (resolution == sf::Vector2u(3840, 2160)) {
-        spacingX = 160.0f; // 4K resolution, further increase spacing
-        spacingY = 110.0f;
-    } else {
-
-    }
-}
-
     /**
      *Updates the position and state of all enemies in the wave.
      *
      * @param metricsBarHeight The height of the metrics bar, used to prevent enemies from overlapping it.
+     * @param deltaTime The time the wave moves for.
      */
-void EnemyWave::update(float metricsBarHeight) {
+void EnemyWave::update(float metricsBarHeight, const sf::Time& deltaTime) {
     float moveRightDistance = 50.0f;
     static bool movingDown = true;
     static bool hasMovedRightAfterReach = false;
@@ -65,7 +39,7 @@ void EnemyWave::update(float metricsBarHeight) {
     for (int i = 0; i < rows; ++i) {
         for (int j = 0; j < columns; ++j) {
             Enemy& enemy = enemyGrid[i][j];
-            if (enemy.getPosition().y + enemy.getGlobalBounds().height > window.getSize().y) {
+            if (enemy.getPosition().y + enemy.getGlobalBounds().height > VirtualView::getSize().y) {
                 bottomReached = true;
                 break;
             }
@@ -91,7 +65,7 @@ void EnemyWave::update(float metricsBarHeight) {
         hasMovedRightAfterReach = true;
         movingDown = !movingDown;
     } else {
-        float moveDistance = movingDown ? 1 : -1;
+        float moveDistance = (movingDown ? 1 : -1) * verticalSpeed * deltaTime.asSeconds();
         for (int i = 0; i < rows; ++i) {
             for (int j = 0; j < columns; ++j) {
                 Enemy& enemy = enemyGrid[i][j];
@@ -108,15 +82,66 @@ void EnemyWave::update(float metricsBarHeight) {
      * Draws all enemies in the wave to the provided render window.
      *
      * @param window The window where enemies will be drawn.
+     * @param alpha How far the frame is between the last simulation tick and the next one.
+     */
+void EnemyWave::draw(sf::RenderTarget& window, float alpha) {
+    // Every enemy samples the gameplay atlas, so the whole formation is a single draw call
+    enemyBatch.clear();
+    enemyBatch.setVisibleArea(VirtualView::getVisibleArea(window.getView()));  // enemies wrapping around are skipped
+    addEnemiesTo(enemyBatch, alpha);
+    window.draw(enemyBatch);
+}
+
+    /**
+     * Adds every live enemy to a batch of sprites.
+     *
+     * @param batch The batch collecting the sprites of the frame.
+     * @param alpha How far the frame is between the last simulation tick and the next one.
      */
-void EnemyWave::draw(sf::RenderWindow& window) {
+void EnemyWave::addEnemiesTo(SpriteBatch& batch, float alpha) const {
     for (int i = 0; i < rows; ++i) {
         for (int j = 0; j < columns; ++j) {
-            enemyGrid[i][j].draw(window);
+            if (enemyGrid[i][j].getIsAlive()) {
+                batch.add(enemyGrid[i][j].getInterpolatedSprite(alpha));
+            }
+        }
+    }
+}
+
+    /**
+     * Adds the bullets of every enemy to a batch of projectiles.
+     *
+     * @param batch The batch collecting the projectiles of the frame.
+     * @param alpha How far the frame is between the last simulation tick and the next one.
+     */
+void EnemyWave::addBulletsTo(SpriteBatch& batch, float alpha) const {
+    for (const auto& row : enemyGrid) {
+        for (const auto& enemy : row) {
+            enemy.addBulletsTo(batch, alpha);
+        }
+    }
+}
+
+    /**
+     * Records the position of every enemy and bullet before a simulation tick moves them.
+     */
+void EnemyWave::recordPositions() {
+    for (auto& row : enemyGrid) {
+        for (auto& enemy : row) {
+            enemy.recordPositions();
         }
     }
 }
 
+    /**
+     * Gets the number of live enemies the last draw() culled because they were outside of the view.
+     *
+     * @return The number of culled enemies.
+     */
+std::size_t EnemyWave::getCulledCount() const {
+    return enemyBatch.getCulledCount();
+}
+
     /**
      * Accesses a specific enemy in the grid.
      *
@@ -183,6 +208,17 @@ void EnemyWave::respawnEnemies(int flag) {
     }
 }
 
+/**
+     * Acquires the texture of every enemy again for the current pixel density of the virtual view.
+     */
+void EnemyWave::reloadTextures() {
+    for (auto& row : enemyGrid) {
+        for (auto& enemy : row) {
+            enemy.reloadTexture();
+        }
+    }
+}
+
 /**
      *Retrieves the total number of enemies spawned by this wave.
      *
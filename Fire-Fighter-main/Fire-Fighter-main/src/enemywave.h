@@ -3,15 +3,14 @@
  * @brief Handles the organization and behavior of enemy waves in the game.
  *
  * The EnemyWave class manages the spawning, organization, and movement of enemy units within the game.
- * It calculates the positioning and spacing of enemies based on the game window's size and resolution,
- * adjusting dynamically to fit a variety of screen sizes. The class also handles enemy wave updates,
+ * It calculates the positioning and spacing of enemies in the virtual space of the game,
+ * which the window view scales to fit a variety of screen sizes. The class also handles enemy wave updates,
  * including movement patterns and respawn mechanisms, to maintain gameplay challenge and variety.
  *
  * @details The class uses a grid to organize enemies, allowing for easy management of enemy positions
  * and states. EnemyWave is responsible for drawing all enemies onto the game window, updating their
  * positions according to predefined patterns, and checking for conditions such as all enemies being defeated.
- * It supports varying resolutions by adjusting the spacing between enemies, ensuring that the game
- * looks consistent across different devices.
+ * Since the formation is laid out in virtual units, the game looks the same across different devices.
  *
  * @author Juyoung Lee, Sungmin Lee
  */
@@ -24,6 +23,7 @@
 #include <string>
 #include "bullet.h"
 #include "enemy.h"
+#include "spritebatch.h"
 #include <cmath>
 #include <iostream>
 
@@ -32,30 +32,51 @@ class EnemyWave {
 
 public:
     /**
-     *Constructor: Initializes an enemy wave within the game environment, setting up initial positions, spacing,
-     *and creating enemies based on the game's window size, resolution, and UI metrics bar height.
+     *Constructor: Initializes an enemy wave within the virtual space of the game, setting up initial positions,
+     *spacing, and creating enemies below the UI metrics bar.
 
-    * @param window
-     * @param resolution
      * @param metricsBarHeight
      */
-    EnemyWave(sf::RenderWindow& window, const sf::Vector2u& resolution, float metricsBarHeight);
+    explicit EnemyWave(float metricsBarHeight);
+
     /**
-     * @brief Updates the positions and states of all enemies in the wave.
+     * @brief Draws all enemies in the wave to the provided render window.
      *
-     * Moves enemies according to their behavior patterns and checks for game events like reaching
-     * the screen edge or player interactions.
+     * Live enemies are collected into a SpriteBatch and drawn with one call, enemies outside of the
+     * view of the target are culled. Their bullets are drawn with the other projectiles, see addBulletsTo().
      *
-     * @param deltaTime The time elapsed since the last frame.
+     * @param window The window where enemies will be drawn.
+     * @param alpha How far the frame is between the last simulation tick and the next one, from 0 to 1.
      */
-    void update(sf::Time deltaTime);
+    void draw(sf::RenderTarget& window, float alpha = 1.f);
 
     /**
-     * @brief Draws all enemies in the wave to the provided render window.
+     * @brief Adds every live enemy to a batch of sprites.
      *
-     * @param window The window where enemies will be drawn.
+     * @param batch The batch collecting the sprites of the frame.
+     * @param alpha How far the frame is between the last simulation tick and the next one, from 0 to 1.
+     */
+    void addEnemiesTo(SpriteBatch& batch, float alpha = 1.f) const;
+
+    /**
+     * @brief Adds the bullets of every enemy to a batch of projectiles.
+     *
+     * @param batch The batch collecting the projectiles of the frame.
+     * @param alpha How far the frame is between the last simulation tick and the next one, from 0 to 1.
+     */
+    void addBulletsTo(SpriteBatch& batch, float alpha = 1.f) const;
+
+    /**
+     * @brief Records the position of every enemy and bullet at the start of a simulation tick.
      */
-    void draw(sf::RenderWindow& window);
+    void recordPositions();
+
+    /**
+     * @brief Gets the number of live enemies the last draw() culled because they were outside of the view.
+     *
+     * @return The number of culled enemies.
+     */
+    std::size_t getCulledCount() const;
 
     /**
      * @brief Accesses a specific enemy in the grid.
@@ -80,13 +101,6 @@ public:
     */
     int getColumns() const;
 
-    /**
-    * @brief Dynamically adjusts enemy spacing based on screen resolution.
-    *
-    * @param resolution The screen resolution to adapt enemy spacing for.
-    */
-    void adjustSpacingForResolution(const sf::Vector2u& resolution);
-
     /**
      * @brief Respawns enemies with potential modifications for difficulty.
      *
@@ -96,6 +110,11 @@ public:
      */
     void respawnEnemies(int flag);
 
+    /**
+     * @brief Acquires the texture of every enemy again for the current pixel density of the virtual view.
+     */
+    void reloadTextures();
+
     /**
      * @brief Checks if all enemies in the wave are defeated.
      *
@@ -118,12 +137,12 @@ public:
      * reach the top or bottom.
      *
      * @param metricsBarHeight The height of the metrics bar, used to prevent enemies from overlapping it.
+     * @param deltaTime The time the wave moves for.
      */
-    void update(float metricsBarHeight);
+    void update(float metricsBarHeight, const sf::Time& deltaTime);
 
 
 private:
-    sf::RenderWindow& window; ///< Reference to the main game window.
     std::vector<std::vector<Enemy>> enemyGrid; ///< 2D vector holding the grid of enemies.
     int rows; ///< Number of rows in the enemy grid.
     int columns; ///< Number of columns in the enemy grid.
@@ -132,6 +151,8 @@ private:
     float startX; ///< X-coordinate for the first enemy in the grid.
     float startY; ///< Y-coordinate for the first enemy, adjusted for the UI's metrics bar.
     int totalSpawned = 0; ///< Counter for the total number of enemies spawned in the wave.
+    float verticalSpeed = 60.f; ///< Speed of the wave moving up and down, in virtual units per second.
+    SpriteBatch enemyBatch; ///< Quads of the live enemies, refilled every frame.
 };
 
 #endif FIRE_FIGHTER_ENEMYWAVE_H
@@ -49,22 +49,42 @@ void Entity::setScale(float scaleX, float scaleY) {
 }
 
 /**
- * @brief Set the texture of the entity.
- * @param texturePath The path to the texture file.
+ * @brief Set the texture of the entity from the texture cache.
+ * @param texturePath The asset id of the texture (path relative to the project root).
+ * @param resolution The resolution of the game, selecting the pre-sized variant of the texture.
  * @return True if the texture was successfully loaded, false otherwise.
  */
-bool Entity::setTexture(const std::string& texturePath) {
-    if (texture.loadFromFile(texturePath)) {
-        sprite.setTexture(texture);
-        return true;
+bool Entity::setTexture(const std::string& texturePath, sf::Vector2u resolution) {
+    textureId = texturePath;
+    texture = TextureCache::getInstance().acquireRegion(texturePath, resolution);
+    if (texture.rect.width == 0) {
+        return false;
     }
-    return false;
+    texture.apply(sprite);
+    return true;
 }
 
 /**
- * @brief Draw the entity on a render window.
- * @param window The render window to draw the entity on.
+ * @brief Acquire the texture again for the current pixel density of the virtual view.
  */
-void Entity::draw(sf::RenderWindow& window) const {
-    window.draw(sprite);
+void Entity::reloadTexture() {
+    if (!textureId.empty()) {
+        setTexture(textureId, VirtualView::getResolution());
+    }
+}
+
+/**
+ * @brief Record the position of the entity at the start of a simulation tick.
+ */
+void Entity::recordPosition() {
+    motion.record(sprite);
+}
+
+/**
+ * @brief Get the sprite of the entity placed between the last two simulation ticks.
+ * @param alpha How far the frame is between the last tick and the next one, from 0 to 1.
+ * @return The sprite to draw.
+ */
+sf::Sprite Entity::getInterpolatedSprite(float alpha) const {
+    return motion.interpolate(sprite, alpha);
 }
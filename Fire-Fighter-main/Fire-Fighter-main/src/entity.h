@@ -2,7 +2,11 @@
 #define FIRE_FIGHTER_ENTITY_H
 
 #include <SFML/Graphics.hpp>
+#include <memory>
 #include "bullet.h"
+#include "texturecache.h"
+#include "virtualview.h"
+#include "interpolator.h"
 
 /**
  * @brief The base class for game entities.
@@ -12,8 +16,10 @@
 class Entity {
 protected:
     sf::Sprite sprite; /**< The sprite representing the entity. */
-    sf::Texture texture; /**< The texture of the entity. */
+    TextureRegion texture; /**< Shared atlas region of the entity. */
+    std::string textureId; /**< Asset id of the texture, to acquire it again when the pixel density changes. */
     std::vector<Bullet>  bullet;  /**< Vector of bullets fired by the entity. */
+    Interpolator motion; /**< Position of the sprite at the previous simulation tick. */
 
 public:
     /**
@@ -50,22 +56,32 @@ public:
      */
     sf::Sprite& getSprite();
     /**
-     * @brief Draw the entity on a render window.
-     * @param window The render window to draw the entity on.
+     * @brief Set the texture of the entity from the texture cache.
+     * @param texturePath The asset id of the texture (path relative to the project root).
+     * @param resolution The resolution of the game, selecting the pre-sized variant of the texture.
+     * @return True if the texture was successfully loaded, false otherwise.
      */
-    void draw(sf::RenderWindow& window) const;
+    bool setTexture(const std::string& texturePath, sf::Vector2u resolution);
     /**
-     * @brief Set the texture of the entity.
-     * @param texturePath The path to the texture file.
-     * @return True if the texture was successfully loaded, false otherwise.
+     * @brief Acquire the texture again for the current pixel density of the virtual view.
      */
-    bool setTexture(const std::string& texturePath);
+    void reloadTexture();
     /**
      * @brief Set the scale of the entity.
      * @param scaleX The scale factor along the x-axis.
      * @param scaleY The scale factor along the y-axis.
      */
     void setScale(float scaleX, float scaleY);
+    /**
+     * @brief Record the position of the entity at the start of a simulation tick.
+     */
+    void recordPosition();
+    /**
+     * @brief Get the sprite of the entity placed between the last two simulation ticks.
+     * @param alpha How far the frame is between the last tick and the next one, from 0 to 1.
+     * @return The sprite to draw.
+     */
+    sf::Sprite getInterpolatedSprite(float alpha) const;
 };
 
 #endif //FIRE_FIGHTER_ENTITY_H
@@ -0,0 +1,55 @@
+#include "fontservice.h"
+
+/**
+ * Private constructor of the FontService.
+ */
+FontService::FontService() = default;
+
+/**
+ * Return the single font service shared by the whole process.
+ * @return Reference to the font service.
+ */
+FontService& FontService::getInstance() {
+    static FontService instance;
+    return instance;
+}
+
+/**
+ * Get the font with the given asset id, loading it on first use.
+ * @param id The asset id of the font (path relative to the project root).
+ * @return Reference to the shared font.
+ */
+const sf::Font& FontService::acquire(const std::string& id) {
+    auto it = fonts.find(id);
+    if (it != fonts.end()) {
+        return it->second;
+    }
+
+    // Fonts keep reading their source, the mapped asset pack stays valid for the whole process
+    sf::Clock clock;
+    sf::Font& font = fonts[id];
+    if (!AssetPack::getInstance().load(id, font)) {
+        std::cerr << "Failed to load font " << id << std::endl;
+        return font;
+    }
+    const void* data;
+    std::size_t size = 0;
+    AssetPack::getInstance().find(id, data, size);      // loose fonts are read lazily, their size is not known
+    LoadReport::getInstance().record(LoadReport::Font, id, clock.getElapsedTime(), size);
+    return font;
+}
+
+/**
+ * Rasterize the glyphs of a set of characters at the given character sizes.
+ * @param id The asset id of the font.
+ * @param characters The characters to rasterize.
+ * @param sizes The character sizes to rasterize them at.
+ */
+void FontService::prewarm(const std::string& id, const sf::String& characters, const std::vector<unsigned>& sizes) {
+    const sf::Font& font = acquire(id);
+    for (unsigned size : sizes) {
+        for (sf::Uint32 character : characters) {
+            font.getGlyph(character, size, false);
+        }
+    }
+}
@@ -0,0 +1,71 @@
+/**
+ * @file fontservice.h
+ * @brief Declaration of the FontService class.
+ */
+
+#ifndef FIRE_FIGHTER_FONTSERVICE_H
+#define FIRE_FIGHTER_FONTSERVICE_H
+
+#include <SFML/Graphics.hpp>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+#include "assetpack.h"
+#include "loadreport.h"
+
+/**
+ * @class FontService
+ * @brief Owns the one instance of every font used by the game.
+ *
+ * Fonts are keyed by asset id and handed out by reference, so the Settings copies held by the
+ * game objects all share the same font and its glyph pages instead of each parsing the file and
+ * rasterizing glyphs again. Fonts stay loaded for the life of the process, so references stay valid.
+ *
+ * Glyphs are normally rasterized the first time a character is drawn at a size, which causes a
+ * hitch in the middle of a game when a new digit first appears in the score. prewarm() rasterizes
+ * a set of characters up front, typically while a menu is being built.
+ */
+class FontService {
+public:
+    /**
+     * @brief Returns the single font service shared by the whole process.
+     * @return Reference to the font service.
+     */
+    static FontService& getInstance();
+
+    /**
+     * @brief Gets the font with the given asset id, loading it on first use.
+     *
+     * If the font cannot be loaded an error message is printed and an empty font is kept under the
+     * id, so a missing file is reported once instead of on every request.
+     *
+     * @param id The asset id of the font (path relative to the project root).
+     * @return Reference to the shared font.
+     */
+    const sf::Font& acquire(const std::string& id);
+
+    /**
+     * @brief Rasterizes the glyphs of a set of characters at the given character sizes.
+     *
+     * Glyphs that are already rasterized are only looked up, so prewarming again is cheap.
+     *
+     * @param id The asset id of the font.
+     * @param characters The characters to rasterize, duplicates are ignored.
+     * @param sizes The character sizes to rasterize them at.
+     */
+    void prewarm(const std::string& id, const sf::String& characters, const std::vector<unsigned>& sizes);
+
+private:
+    /**
+     * @brief Private constructor, use getInstance() to access the font service.
+     */
+    FontService();
+
+    FontService(const FontService&) = delete;
+    FontService& operator=(const FontService&) = delete;
+
+    std::map<std::string, sf::Font> fonts; ///< Loaded fonts by asset id.
+};
+
+#endif //FIRE_FIGHTER_FONTSERVICE_H
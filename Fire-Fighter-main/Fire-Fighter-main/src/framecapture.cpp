@@ -0,0 +1,227 @@
+#include "framecapture.h"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+/**
+ * Construct the capture and start its worker threads.
+ * @param directory Directory the frames are saved to, created on the first capture.
+ * @param ringSize Number of staging textures, the most frames waiting to be written.
+ * @param workerCount Number of threads encoding and writing frames.
+ */
+FrameCapture::FrameCapture(const std::string& directory, std::size_t ringSize, std::size_t workerCount)
+        : directory(directory), ring(std::max<std::size_t>(ringSize, 1)), next(0), pending(0), stopping(false),
+          screenshotRequested(false), recording(false), recordingFormat(Format::Png), recordings(0),
+          screenshots(0), currentRecording(0), recordedFrames(0),
+          captured(0), written(0), dropped(0), failed(0) {
+    for (std::size_t i = 0; i < std::max<std::size_t>(workerCount, 1); ++i) {
+        workers.emplace_back(&FrameCapture::work, this);
+    }
+}
+
+/**
+ * Destructor of the FrameCapture, writes the frames still waiting and joins the worker threads.
+ */
+FrameCapture::~FrameCapture() {
+    finish();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+/**
+ * Capture the next grabbed frame as a PNG screenshot.
+ */
+void FrameCapture::requestScreenshot() {
+    screenshotRequested = true;
+}
+
+/**
+ * Capture every grabbed frame until stopRecording().
+ * @param format File format of the frames.
+ */
+void FrameCapture::startRecording(Format format) {
+    recordingFormat = format;
+    ++recordings;
+    recording = true;
+}
+
+/**
+ * Stop the recording.
+ */
+void FrameCapture::stopRecording() {
+    recording = false;
+}
+
+/**
+ * Check if a recording is running.
+ * @return True between startRecording() and stopRecording().
+ */
+bool FrameCapture::isRecording() const {
+    return recording;
+}
+
+/**
+ * Capture the frame drawn to a window if a screenshot or recording asks for it.
+ * @param window The window the frame was drawn to.
+ */
+void FrameCapture::grab(const sf::Window& window) {
+    bool screenshot = screenshotRequested.exchange(false);
+    bool record = recording;
+    if (!screenshot && !record) {
+        return;
+    }
+    sf::Clock clock;
+
+    // Name the frame first, so a dropped frame leaves a gap in the numbers of a recording
+    std::ostringstream path;
+    path << directory << '/';
+    Format format = Format::Png;
+    if (screenshot) {
+        path << "screenshot" << std::setw(3) << std::setfill('0') << ++screenshots;
+    } else {
+        if (currentRecording != recordings) {
+            currentRecording = recordings;
+            recordedFrames = 0;
+        }
+        path << "recording" << currentRecording << '_' << std::setw(5) << std::setfill('0') << recordedFrames++;
+        format = recordingFormat;
+    }
+    path << '_' << window.getSize().x << 'x' << window.getSize().y;
+
+    // Take the next staging texture the workers are done with, or drop the frame
+    std::size_t slot = ring.size();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (std::size_t i = 0; i < ring.size() && slot == ring.size(); ++i) {
+            std::size_t candidate = (next + i) % ring.size();
+            if (!ring[candidate].busy) {
+                slot = candidate;
+            }
+        }
+        if (slot == ring.size()) {
+            ++dropped;
+            grabTime += clock.getElapsedTime();
+            return;
+        }
+        ring[slot].busy = true;
+        next = (slot + 1) % ring.size();
+    }
+
+    // Only this thread touches a busy staging texture until its job is queued
+    sf::Texture& staging = ring[slot].texture;
+    if (staging.getSize() != window.getSize() && !staging.create(window.getSize().x, window.getSize().y)) {
+        std::cerr << "Failed to create a staging texture for frame capture" << std::endl;
+        std::lock_guard<std::mutex> lock(mutex);
+        ring[slot].busy = false;
+        ++failed;
+        return;
+    }
+    staging.update(window);     // copied on the graphics card, read back by a worker
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        jobs.push_back({slot, path.str(), format});
+        ++pending;
+        ++captured;
+        sf::Time elapsed = clock.getElapsedTime();
+        grabTime += elapsed;
+        longestGrab = std::max(longestGrab, elapsed);
+    }
+    wake.notify_one();
+}
+
+/**
+ * Wait until every captured frame is written.
+ */
+void FrameCapture::finish() {
+    std::unique_lock<std::mutex> lock(mutex);
+    idle.wait(lock, [this] { return pending == 0; });
+}
+
+/**
+ * Print the capture statistics since the last report and reset them.
+ * @param title Name of the captured part of the game, printed in the header.
+ * @param out The stream to print to.
+ */
+void FrameCapture::printReport(const std::string& title, std::ostream& out) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (captured == 0 && dropped == 0) {
+        return;
+    }
+    std::size_t grabs = captured + dropped;
+    out << std::fixed << std::setprecision(2);
+    out << "--- Frame capture: " << title << " (" << captured << " captured, " << written << " written, "
+        << dropped << " dropped, " << failed << " failed)" << std::endl;
+    out << "  grab     mean " << grabTime.asSeconds() * 1000.f / grabs << " ms, max " << longestGrab.asSeconds() * 1000.f << " ms" << std::endl;
+    out << std::defaultfloat;
+
+    captured = 0;
+    written = 0;
+    dropped = 0;
+    failed = 0;
+    grabTime = sf::Time::Zero;
+    longestGrab = sf::Time::Zero;
+}
+
+/**
+ * Body of the worker threads, reads back, encodes and writes frames until the capture is destroyed.
+ */
+void FrameCapture::work() {
+    while (true) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [this] { return !jobs.empty() || stopping; });
+            if (jobs.empty()) {
+                return;
+            }
+            job = jobs.front();
+            jobs.pop_front();
+        }
+
+        // SFML gives this thread a context of its own, sharing the staging texture
+        sf::Image image = ring[job.slot].texture.copyToImage();
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            ring[job.slot].busy = false;
+        }
+        bool ok = write(image, job);
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            ++(ok ? written : failed);
+            --pending;
+        }
+        idle.notify_all();
+    }
+}
+
+/**
+ * Write a frame to a file.
+ * @param image The pixels of the frame.
+ * @param job The job of the frame.
+ * @return True if the file was written, false otherwise.
+ */
+bool FrameCapture::write(const sf::Image& image, const Job& job) const {
+    std::error_code error;
+    std::filesystem::create_directories(directory, error);
+    if (job.format == Format::Png) {
+        return image.saveToFile(job.path + ".png");     // prints its own error
+    }
+
+    std::ofstream file(job.path + ".rgba", std::ios::binary);
+    std::size_t size = static_cast<std::size_t>(image.getSize().x) * image.getSize().y * 4;
+    if (!file || !file.write(reinterpret_cast<const char*>(image.getPixelsPtr()), static_cast<std::streamsize>(size))) {
+        std::cerr << "Failed to write " << job.path << ".rgba" << std::endl;
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,158 @@
+/**
+ * @file framecapture.h
+ * @brief Declaration of the FrameCapture class.
+ */
+
+#ifndef FIRE_FIGHTER_FRAMECAPTURE_H
+#define FIRE_FIGHTER_FRAMECAPTURE_H
+
+#include <SFML/Graphics.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @class FrameCapture
+ * @brief Saves screenshots and recordings of the window without stalling the game.
+ *
+ * Reading a frame back from the graphics card and encoding it takes tens of milliseconds at 4K, far
+ * too long for the game thread. A capture only copies the window into a staging texture on the
+ * graphics card, which returns right away; worker threads read the texture back, encode it and write
+ * it to disk. The staging textures form a ring, so the number of frames waiting to be written is
+ * bounded: when every staging texture is still in use, the frame is dropped and counted instead of
+ * waiting, which keeps recordings from slowing the game down on slow disks.
+ *
+ * Frames are written as PNG images, or for recordings optionally as raw RGBA pixels, which cost
+ * nothing to encode. The files are numbered and named after the frame size, e.g.
+ * recording2_00042_1920x1080.rgba.
+ */
+class FrameCapture {
+public:
+    /**
+     * @brief File format of the captured frames.
+     */
+    enum class Format {
+        Png, ///< Compressed PNG images, smaller but slow to encode.
+        Raw  ///< Uncompressed RGBA pixels, rows from top to bottom.
+    };
+
+    /**
+     * @brief Constructs the capture and starts its worker threads.
+     * @param directory Directory the frames are saved to, created on the first capture.
+     * @param ringSize Number of staging textures, the most frames waiting to be written.
+     * @param workerCount Number of threads encoding and writing frames.
+     */
+    explicit FrameCapture(const std::string& directory = "../../captures", std::size_t ringSize = 4, std::size_t workerCount = 2);
+
+    /**
+     * @brief Destructor, writes the frames still waiting and stops the worker threads.
+     */
+    ~FrameCapture();
+
+    /**
+     * @brief Captures the next grabbed frame as a PNG screenshot. Can be called from any thread.
+     */
+    void requestScreenshot();
+
+    /**
+     * @brief Captures every grabbed frame until stopRecording(). Can be called from any thread.
+     * @param format File format of the frames.
+     */
+    void startRecording(Format format);
+
+    /**
+     * @brief Stops the recording. Can be called from any thread.
+     */
+    void stopRecording();
+
+    /**
+     * @brief Checks if a recording is running.
+     * @return True between startRecording() and stopRecording().
+     */
+    bool isRecording() const;
+
+    /**
+     * @brief Captures the frame drawn to a window if a screenshot or recording asks for it.
+     *
+     * Call it after drawing the frame and before sf::Window::display(), on the thread drawing to the window.
+     *
+     * @param window The window the frame was drawn to.
+     */
+    void grab(const sf::Window& window);
+
+    /**
+     * @brief Waits until every captured frame is written.
+     */
+    void finish();
+
+    /**
+     * @brief Prints how many frames were captured, written and dropped, and what grabbing cost, then resets the counts.
+     * @param title Name of the captured part of the game, printed in the header.
+     * @param out The stream to print to.
+     */
+    void printReport(const std::string& title, std::ostream& out = std::cout);
+
+private:
+    /**
+     * @brief A staging texture of the ring.
+     */
+    struct Staging {
+        sf::Texture texture; ///< Copy of the captured frame on the graphics card.
+        bool busy = false; ///< Flag indicating whether the frame was not read back yet.
+    };
+
+    /**
+     * @brief A captured frame waiting for a worker.
+     */
+    struct Job {
+        std::size_t slot; ///< Index of the staging texture holding the frame.
+        std::string path; ///< File to write the frame to, without extension.
+        Format format; ///< File format of the frame.
+    };
+
+    /**
+     * @brief Body of the worker threads, reads back, encodes and writes frames.
+     */
+    void work();
+
+    /**
+     * @brief Writes a frame to a file.
+     * @param image The pixels of the frame.
+     * @param job The job of the frame.
+     * @return True if the file was written, false otherwise.
+     */
+    bool write(const sf::Image& image, const Job& job) const;
+
+    std::string directory; ///< Directory the frames are saved to.
+    std::vector<Staging> ring; ///< Staging textures, never resized so the workers can keep indices.
+    std::size_t next; ///< Index of the staging texture to try first.
+    std::vector<std::thread> workers; ///< Threads encoding and writing frames.
+    std::mutex mutex; ///< Guards the ring flags, the jobs and the counts.
+    std::condition_variable wake; ///< Signalled when a job was added or on shutdown.
+    std::condition_variable idle; ///< Signalled when a job was finished.
+    std::deque<Job> jobs; ///< Captured frames waiting for a worker.
+    std::size_t pending; ///< Frames captured but not written yet.
+    bool stopping; ///< Flag telling the workers to finish.
+
+    std::atomic<bool> screenshotRequested; ///< Flag asking for a screenshot of the next frame.
+    std::atomic<bool> recording; ///< Flag indicating whether every frame is captured.
+    std::atomic<Format> recordingFormat; ///< File format of the recorded frames.
+    std::atomic<unsigned> recordings; ///< Number of recordings started, to number them.
+    unsigned screenshots; ///< Number of screenshots taken, to number them.
+    unsigned currentRecording; ///< Number of the recording the last recorded frame belonged to.
+    unsigned recordedFrames; ///< Frames of the current recording, to number them.
+
+    std::size_t captured; ///< Frames copied to a staging texture since the last report.
+    std::size_t written; ///< Frames written to disk since the last report.
+    std::size_t dropped; ///< Frames dropped because every staging texture was busy since the last report.
+    std::size_t failed; ///< Frames that could not be written since the last report.
+    sf::Time grabTime; ///< Time spent in grab() on the drawing thread since the last report.
+    sf::Time longestGrab; ///< Longest grab() since the last report.
+};
+
+#endif //FIRE_FIGHTER_FRAMECAPTURE_H
@@ -0,0 +1,128 @@
+#include "framepacer.h"
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <thread>
+
+const sf::Time FramePacer::spinThreshold = sf::milliseconds(2);
+
+/**
+ * Construct a pacer for an uncapped frame rate.
+ */
+FramePacer::FramePacer() {
+    resetStatistics();
+}
+
+/**
+ * Set the frame rate and vertical sync, and turn off the window's own frame limit.
+ * @param window The window the frames are shown in.
+ * @param frameRate The target frame rate in frames per second, 0 for uncapped.
+ * @param vsync True to synchronize with the vertical refresh of the display.
+ */
+void FramePacer::configure(sf::Window& window, unsigned frameRate, bool vsync) {
+    window.setFramerateLimit(0);        // the pacer waits instead of the window
+    window.setVerticalSyncEnabled(vsync);
+    period = frameRate > 0 ? sf::seconds(1.f / static_cast<float>(frameRate)) : sf::Time::Zero;
+    deadline = clock.getElapsedTime() + period;
+    frameEnd = clock.getElapsedTime();
+}
+
+/**
+ * Get the duration of a frame at the target frame rate.
+ * @return The frame period, sf::Time::Zero if the frame rate is uncapped.
+ */
+sf::Time FramePacer::getTargetFrameTime() const {
+    return period;
+}
+
+/**
+ * Wait for the end of the current frame.
+ */
+void FramePacer::wait() {
+    if (period != sf::Time::Zero) {
+        sf::Time now = clock.getElapsedTime();
+        if (now > deadline + period) {
+            deadline = now;     // too far behind to catch up, start a new cadence from here
+        } else {
+            // Sleep for the coarse part of the wait, sleeping can overshoot so the rest is spun
+            if (deadline - now > spinThreshold) {
+                sf::sleep(deadline - now - spinThreshold);
+            }
+            while (clock.getElapsedTime() < deadline) {
+                std::this_thread::yield();
+            }
+        }
+        deadline += period;
+    }
+
+    sf::Time now = clock.getElapsedTime();
+    frameTime = now - frameEnd;
+    frameEnd = now;
+
+    double seconds = frameTime.asSeconds();
+    ++frames;
+    sum += seconds;
+    sumOfSquares += seconds * seconds;
+    shortest = std::min(shortest, frameTime);
+    longest = std::max(longest, frameTime);
+    if (period != sf::Time::Zero && frameTime > period + period / 2.f) {
+        ++lateFrames;
+    }
+}
+
+/**
+ * Get the time between the last two frames.
+ * @return The duration of the last frame.
+ */
+sf::Time FramePacer::getLastFrameTime() const {
+    return frameTime;
+}
+
+/**
+ * Start the next frame now, leaving the time since the last wait() out of the frame times.
+ */
+void FramePacer::restartFrame() {
+    sf::Time now = clock.getElapsedTime();
+    deadline += now - frameEnd;     // the skipped time does not eat into the next frame either
+    frameEnd = now;
+}
+
+/**
+ * Forget the frame times measured so far.
+ */
+void FramePacer::resetStatistics() {
+    frames = 0;
+    lateFrames = 0;
+    sum = 0.0;
+    sumOfSquares = 0.0;
+    shortest = sf::seconds(3600.f);
+    longest = sf::Time::Zero;
+    frameEnd = clock.getElapsedTime();
+}
+
+/**
+ * Print the frame time statistics since the last report and reset them.
+ * @param title Name of the measured part of the game, printed in the header.
+ * @param out The stream to print to.
+ */
+void FramePacer::printReport(const std::string& title, std::ostream& out) {
+    if (frames == 0) {
+        return;
+    }
+    double mean = sum / frames;
+    double variance = std::max(0.0, sumOfSquares / frames - mean * mean);
+
+    out << std::fixed << std::setprecision(2);
+    out << "--- Frame pacing: " << title << " (" << frames << " frames, " << lateFrames << " late)" << std::endl;
+    if (period == sf::Time::Zero) {
+        out << "  target   uncapped" << std::endl;
+    } else {
+        out << "  target   " << std::lround(1.0 / period.asSeconds()) << " fps" << std::endl;
+    }
+    out << "  mean     " << mean * 1000.0 << " ms (" << (mean > 0.0 ? 1.0 / mean : 0.0) << " fps)" << std::endl;
+    out << "  std dev  " << std::sqrt(variance) * 1000.0 << " ms" << std::endl;
+    out << "  min/max  " << shortest.asSeconds() * 1000.f << " / " << longest.asSeconds() * 1000.f << " ms" << std::endl;
+    out << std::defaultfloat;
+
+    resetStatistics();
+}
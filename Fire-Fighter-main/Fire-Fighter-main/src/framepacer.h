@@ -0,0 +1,97 @@
+/**
+ * @file framepacer.h
+ * @brief Declaration of the FramePacer class.
+ */
+
+#ifndef FIRE_FIGHTER_FRAMEPACER_H
+#define FIRE_FIGHTER_FRAMEPACER_H
+
+#include <SFML/Window.hpp>
+#include <SFML/System.hpp>
+#include <iostream>
+#include <string>
+
+/**
+ * @class FramePacer
+ * @brief Ends every frame on a fixed cadence at the configured frame rate.
+ *
+ * sf::Window::setFramerateLimit() only sleeps, and a sleep can overshoot by a millisecond or more,
+ * which shows up as uneven motion on high refresh displays. The pacer keeps an absolute deadline
+ * for the end of each frame instead: it sleeps until shortly before the deadline and spins for the
+ * rest, so frames end on time without burning a core for the whole wait. Deadlines advance by the
+ * frame period, so a slightly late frame is made up by the next one; a frame that is late by more
+ * than a whole period restarts the cadence instead of rushing to catch up.
+ *
+ * Any frame rate works, 0 leaves the frame rate uncapped. Vertical sync can be enabled on top of it.
+ *
+ * The pacer also measures the time between frames and reports its mean, standard deviation and
+ * extremes, to check how even the frames actually are.
+ */
+class FramePacer {
+public:
+    /**
+     * @brief Constructs a pacer for an uncapped frame rate.
+     */
+    FramePacer();
+
+    /**
+     * @brief Sets the frame rate and vertical sync, and turns off the window's own frame limit.
+     * @param window The window the frames are shown in.
+     * @param frameRate The target frame rate in frames per second, 0 for uncapped.
+     * @param vsync True to synchronize with the vertical refresh of the display.
+     */
+    void configure(sf::Window& window, unsigned frameRate, bool vsync);
+
+    /**
+     * @brief Gets the duration of a frame at the target frame rate.
+     * @return The frame period, sf::Time::Zero if the frame rate is uncapped.
+     */
+    sf::Time getTargetFrameTime() const;
+
+    /**
+     * @brief Waits for the end of the current frame, call it right after sf::Window::display().
+     */
+    void wait();
+
+    /**
+     * @brief Gets the time between the last two frames.
+     * @return The duration of the last frame.
+     */
+    sf::Time getLastFrameTime() const;
+
+    /**
+     * @brief Starts the next frame now, leaving the time since the last wait() out of the frame times.
+     *
+     * Call it after work between frames that should not be measured, such as saving a frame to disk.
+     */
+    void restartFrame();
+
+    /**
+     * @brief Forgets the frame times measured so far, e.g. after a loading screen.
+     */
+    void resetStatistics();
+
+    /**
+     * @brief Prints the frame time statistics since the last report and resets them.
+     * @param title Name of the measured part of the game, printed in the header.
+     * @param out The stream to print to.
+     */
+    void printReport(const std::string& title, std::ostream& out = std::cout);
+
+private:
+    static const sf::Time spinThreshold; ///< Time before the deadline from which the pacer spins instead of sleeping.
+
+    sf::Clock clock; ///< Time since the pacer was constructed, the time base of the deadlines.
+    sf::Time period; ///< Duration of a frame, zero for uncapped.
+    sf::Time deadline; ///< When the current frame should end.
+    sf::Time frameEnd; ///< When the last frame ended.
+    sf::Time frameTime; ///< Duration of the last frame.
+    std::size_t frames; ///< Frames measured since the last report.
+    std::size_t lateFrames; ///< Frames longer than one and a half periods since the last report.
+    double sum; ///< Sum of the measured frame times in seconds.
+    double sumOfSquares; ///< Sum of the squared frame times, for the variance.
+    sf::Time shortest; ///< Shortest measured frame.
+    sf::Time longest; ///< Longest measured frame.
+};
+
+#endif //FIRE_FIGHTER_FRAMEPACER_H
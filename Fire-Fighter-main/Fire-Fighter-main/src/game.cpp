@@ -1,4 +1,9 @@
 #include "game.h"
+#include <filesystem>
+#include <iomanip>
+#include <sstream>
+
+const sf::Time Game::simulationStep = sf::seconds(1.f / 30.f);
 
 /**
  * Constructs the Game object with game settings.
@@ -6,24 +11,40 @@
  * @param opt A pointer to the Settings object containing game settings.
  * @author Robert Andrew Biernacki, Chaewon Eom, Prachi Ghevaria, JuYoung Lee, Sungmin Lee
  */
-Game::Game(Settings *opt) : metrics(opt->getVector(), opt), barrier1(*opt), barrier2(*opt), barrier3(*opt) {
+Game::Game(Settings *opt) : metrics(opt), barrier1(*opt), barrier2(*opt), barrier3(*opt), powerup(*opt), player(nullptr), enemyWave(nullptr) {
     options = *opt;             // settings
-    font = options.getFont();   // load font from settings
+    font = &options.getFont();  // shared font from settings
     icon = options.getIcon();   // load icon from settings
-    if (options.toggleMusic()) {// check if music is enabled, if so, load it into memory
-        if (!music.openFromFile("../../music/rglk2theme2distort.mp3"))
-            std::cerr << "Failed to load music" << std::endl;
-        music.setLoop(true);
+    if (options.toggleMusic()) {// check if music is enabled, if so, open it in the background
+        MusicService::getInstance().prefetch("music/rglk2theme2distort.mp3");
     }
     resolution = opt->getVector();
     // setup window, fame rate, and icon
     sf::VideoMode fullScreenMode = sf::VideoMode::getDesktopMode();
     window.create((options.isFullScreen()) ? fullScreenMode : sf::VideoMode(options.getResolution()[0],options.getResolution()[1]), "Fire Fighter", (options.isFullScreen() || options.getResolution()[0] >= fullScreenMode.width) ? sf::Style::Fullscreen : sf::Style::Default);
     window.setIcon(icon.getSize().x, icon.getSize().y, icon.getPixelsPtr()); // Set the window icon
-    window.setFramerateLimit(60);
+    configurePacing();
+    applyResolution(window.getSize());
 
-    player = new Player(window);
-    enemyWave = new EnemyWave(window, options.getVector(), options.getVector().y *0.1f);
+    player = new Player(&options);
+    enemyWave = new EnemyWave(VirtualView::getSize().y * 0.1f);
+}
+
+/**
+ * Constructs the Game object for the headless benchmark, without a window.
+ *
+ * @param opt A pointer to the Settings object containing game settings.
+ * @param headless The options of the benchmark.
+ */
+Game::Game(Settings *opt, const HeadlessOptions& headless) : metrics(opt), barrier1(*opt), barrier2(*opt), barrier3(*opt), powerup(*opt), player(nullptr), enemyWave(nullptr), headless(headless) {
+    options = *opt;
+    font = &options.getFont();
+    resolution = headless.size;
+    metrics.setSavesHighestScore(false);    // a scripted run must not replace the player's highest score
+    applyResolution(headless.size);
+
+    player = new Player(&options);
+    enemyWave = new EnemyWave(VirtualView::getSize().y * 0.1f);
 }
 
 /**
@@ -33,6 +54,7 @@ Game::Game(Settings *opt) : metrics(opt->getVector(), opt), barrier1(*opt), barr
  */
 
 Game::~Game() {
+    renderThread.stop();
     if (window.isOpen()) {
         window.close();
     }
@@ -55,37 +77,40 @@ void Game::gameLoop() {
     char* str = characterSelectScreen();                           // character selection screen method call
     if (str == NULL) return;                                       // an error has occurred or user exited back to UI
     else player->setPlayerTexture(str);                         // test player texture to selected file path of str
+    SceneManager::getInstance().enterScene(Scene::Gameplay, options.getVector());  // drop the character select images
 
     spetsnaz:
 
-    // setup barrier
-    int useableHeight = options.getResolution()[1] - (options.getResolution()[1] * 0.1f);
-    barrier1.setPosition(options.getResolution()[0] * 0.83f, useableHeight * 0.25f);
-    barrier2.setPosition(options.getResolution()[0] * 0.83f, useableHeight * 0.55f);
-    barrier3.setPosition(options.getResolution()[0] * 0.83f, useableHeight * 0.85f);
+    // setup barrier, everything in the game is placed in the virtual space
+    const sf::Vector2f area = VirtualView::getSize();
+    placeBarriers();
 
     //set up enemy
-    float metricsBarHeight = options.getVector().y *0.1;                                 // Example height, adjust as needed
+    float metricsBarHeight = area.y * 0.1f;                                 // Example height, adjust as needed
     metrics.setEnemyCount(enemyWave->getTotalSpawned());             // setup metrics bar on top of the window
 
     sf::Clock shootCooldown;                                        // for shooting cool down
     bool canShoot = true;
-    float movementSpeed = 0.5f;
-    if (options.toggleMusic()) music.play();                        // start the music if it is enabled
+    const float movementStep = player->getMovementSpeed() * simulationStep.asSeconds();   // player movement in one tick
+    const sf::Time maxFrameTime = sf::seconds(0.25f);               // longest frame time simulated at once
+    sf::Time lag = sf::Time::Zero;                                  // time not simulated yet
+    std::size_t culledTotal = 0, culledMost = 0, frames = 0;        // culling statistics of this game
+    if (options.toggleMusic()) MusicService::getInstance().play("music/rglk2theme2distort.mp3");   // crossfade from the menu music if it is enabled
     bool restFlag = false;
 
     /********************************************/
     // Create the rounded rectangle shape (using a simple rectangle for demonstration)
-    sf::RectangleShape roundedRect(sf::Vector2f(options.widthScaling(300), options.heightScaling(100))); // Set the size of your button
+    sf::RectangleShape roundedRect(sf::Vector2f(300.f, 100.f)); // Set the size of your button
     roundedRect.setFillColor(sf::Color(231, 76, 60)); // Button color
     roundedRect.setOutlineColor(sf::Color(150, 40, 27)); // Outline color
 
     // Center the button on the screen
     roundedRect.setOrigin(roundedRect.getSize() / 2.f);
-    roundedRect.setPosition(window.getSize().x / 2.f, window.getSize().y / 2.f);
+    roundedRect.setPosition(area.x / 2.f, area.y / 2.f);
 
     // Create the stageText
-    sf::Text stageText("Stage: 1", font, options.widthScaling(50)); // Adjust the size accordingly
+    sf::Text stageText("Stage: 1", *font);
+    VirtualView::setCharacterSize(stageText, 50.f, pixelDensity); // sharp at the size it is shown at
     stageText.setFillColor(sf::Color::White); // Text color
 
     // Center the stageText on the button
@@ -102,95 +127,162 @@ void Game::gameLoop() {
 
 /****************************/
 /** main game loop */
+    pacer.resetStatistics();    // measure the frames of the game, not the screens before it
     while (window.isOpen()) {
         sf::Event event{};
         sf::Time deltaTime = clock.restart();
         // when user closes the window through press of X or red dot on mac, close game loop
         while (window.pollEvent(event)) {
-            if (event.type == sf::Event::Closed)
+            if (event.type == sf::Event::Closed) {
+                renderThread.stop();
                 window.close();
-        }
-        // Move character North
-        if (sf::Keyboard::isKeyPressed(sf::Keyboard::Up)) {
-            if (player->getPosition().y - movementSpeed >= window.getSize().y * 0.1f) {
-                player->move(sf::Vector2f(0.f, -movementSpeed));
             }
-        }
-        // Move character South
-        if (sf::Keyboard::isKeyPressed(sf::Keyboard::Down)) {
-            if (player->getPosition().y + player->getSize().y + movementSpeed <= window.getSize().y) {
-                player->move(sf::Vector2f(0.f, movementSpeed));
+            // the game keeps running in the virtual space, only the view and the text rasterization change
+            if (event.type == sf::Event::Resized) {
+                renderThread.stop();    // the texts are rasterized again on this thread
+                applyResolution(sf::Vector2u(event.size.width, event.size.height));
+                VirtualView::setCharacterSize(stageText, 50.f, pixelDensity);
+                textRect = stageText.getLocalBounds();
+                stageText.setOrigin(textRect.left + textRect.width / 2.0f, textRect.top + textRect.height / 2.0f);
+            }
+            // F11 saves a screenshot, F12 starts and stops a recording, of raw frames with Shift
+            if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::F11) {
+                capture.requestScreenshot();
+            }
+            if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::F12) {
+                if (capture.isRecording()) capture.stopRecording();
+                else capture.startRecording(event.key.shift ? FrameCapture::Format::Raw : FrameCapture::Format::Png);
             }
         }
         // when user presses exit, pop up window
         if (sf::Keyboard::isKeyPressed(sf::Keyboard::Escape)) {
-            if (options.toggleMusic()) music.stop();
+            if (options.toggleMusic()) MusicService::getInstance().stop();
             bool flag = handleExitRequest();
             if (flag) window.close();
+            else SceneManager::getInstance().enterScene(Scene::Gameplay, options.getVector());
+            clock.restart();    // the game was paused, do not simulate the time spent in the menu
+            lag = sf::Time::Zero;
+            pacer.restartFrame();   // nor measure it as a frame of the game
         }
         // when the game has ended
         if (sf::Keyboard::isKeyPressed(sf::Keyboard::F)) {
-            if (options.toggleMusic()) music.stop();
+            if (options.toggleMusic()) MusicService::getInstance().stop();
             bool flag = gameOverScreen();
             if (!flag) restFlag = true;
             window.close();
         }
-        // have player shoot when space bar is pressed
-        if (sf::Keyboard::isKeyPressed(sf::Keyboard::Space) && canShoot) {
-            player->shoot();
-            shootCooldown.restart();
-            canShoot = false;
-        }
-        if (shootCooldown.getElapsedTime().asSeconds() > 0.5f) {
-            canShoot = true;
-        }
 
-        // Update enemy movement and shooting
-        for (int i = 0; i < enemyWave->getRows(); ++i) {
-            for (int j = 0; j < enemyWave->getColumns(); ++j) {
-                enemyWave->getEnemy(i, j).update(deltaTime);
+        // Simulate in fixed ticks for the time that passed, a long stall is not caught up all at once
+        lag += std::min(deltaTime, maxFrameTime);
+        while (lag >= simulationStep && window.isOpen()) {
+            lag -= simulationStep;
+            recordPositions();
+            // Move character North
+            if (sf::Keyboard::isKeyPressed(sf::Keyboard::Up)) {
+                if (player->getPosition().y - movementStep >= area.y * 0.1f) {
+                    player->move(sf::Vector2f(0.f, -1.f), simulationStep);
+                }
+            }
+            // Move character South
+            if (sf::Keyboard::isKeyPressed(sf::Keyboard::Down)) {
+                if (player->getPosition().y + player->getSize().y + movementStep <= area.y) {
+                    player->move(sf::Vector2f(0.f, 1.f), simulationStep);
+                }
+            }
+            // have player shoot when space bar is pressed
+            if (sf::Keyboard::isKeyPressed(sf::Keyboard::Space) && canShoot) {
+                player->shoot();
+                shootCooldown.restart();
+                canShoot = false;
+            }
+            if (shootCooldown.getElapsedTime().asSeconds() > 0.5f) {
+                canShoot = true;
+            }
+
+            // Update enemy movement and shooting
+            for (int i = 0; i < enemyWave->getRows(); ++i) {
+                for (int j = 0; j < enemyWave->getColumns(); ++j) {
+                    enemyWave->getEnemy(i, j).update(simulationStep);
 
-                // Check if the enemy has no other enemy on its right
-                bool hasEnemyOnRight = (j < enemyWave->getColumns() - 1) && enemyWave->getEnemy(i, j+1).getIsAlive();
+                    // Check if the enemy has no other enemy on its right
+                    bool hasEnemyOnRight = (j < enemyWave->getColumns() - 1) && enemyWave->getEnemy(i, j+1).getIsAlive();
 
-                // Get a random shoot interval between 1 and 3 seconds
-                static std::vector<sf::Clock> enemyShootClocks(enemyWave->getRows()); // Static to persist between frames
-                static std::random_device rd;
-                static std::mt19937 gen(rd());
-                static std::uniform_int_distribution<> dis(2, 13);
+                    // Get a random shoot interval between 1 and 3 seconds
+                    static std::vector<sf::Clock> enemyShootClocks(enemyWave->getRows()); // Static to persist between frames
+                    static std::random_device rd;
+                    static std::mt19937 gen(rd());
+                    static std::uniform_int_distribution<> dis(2, 13);
 
-                // Check if enough time has passed since the last shot for this enemy
-                if (!hasEnemyOnRight && enemyShootClocks[i].getElapsedTime().asSeconds() >= dis(gen) &&  enemyWave->getEnemy(i, j).getIsAlive() ) {
-                    enemyWave->getEnemy(i, j).shoot();
-                    enemyShootClocks[i].restart(); // Reset the shoot timer
+                    // Check if enough time has passed since the last shot for this enemy
+                    if (!hasEnemyOnRight && enemyShootClocks[i].getElapsedTime().asSeconds() >= dis(gen) &&  enemyWave->getEnemy(i, j).getIsAlive() ) {
+                        enemyWave->getEnemy(i, j).shoot();
+                        enemyShootClocks[i].restart(); // Reset the shoot timer
+                    }
                 }
             }
-        }
 
-        int lives = player->getLives();
-        metrics.updateHealthbar(lives);
+            int lives = player->getLives();
+            metrics.updateHealthbar(lives);
 
-        powerup.update(deltaTime, player, window);
-        player->updateBullets(deltaTime, *enemyWave, metrics);
-        if (enemyWave->allEnemiesDead()) {
-            enemyWave->respawnEnemies(0); // Respawn with increased speed
-        }
-        /** end of enemy stuff */
-        // Update and draw enemies using EnemyWave
-        enemyWave->update(metricsBarHeight);
-
-        //check enemy's bullet collide with player
-        for (int i = 0; i < enemyWave->getRows(); ++i) {
-            for (int j = 0; j < enemyWave->getColumns(); ++j) {
-                Enemy &enemy = enemyWave->getEnemy(i, j);
-                auto& bullets = enemy.getBullets();
-                auto bulletIt = bullets.begin();
-                while (bulletIt != bullets.end()) {
-                    bool bulletRemoved = false;
-                    if (bulletIt->getGlobalBounds().intersects(player->getSprite().getGlobalBounds())) {
+            powerup.update(simulationStep, player);
+            player->updateBullets(simulationStep, *enemyWave, metrics);
+            if (enemyWave->allEnemiesDead()) {
+                enemyWave->respawnEnemies(0); // Respawn with increased speed
+            }
+            /** end of enemy stuff */
+            // Update and draw enemies using EnemyWave
+            enemyWave->update(metricsBarHeight, simulationStep);
+
+            //check enemy's bullet collide with player
+            for (int i = 0; i < enemyWave->getRows(); ++i) {
+                for (int j = 0; j < enemyWave->getColumns(); ++j) {
+                    Enemy &enemy = enemyWave->getEnemy(i, j);
+                    auto& bullets = enemy.getBullets();
+                    auto bulletIt = bullets.begin();
+                    while (bulletIt != bullets.end()) {
+                        bool bulletRemoved = false;
+                        if (bulletIt->getGlobalBounds().intersects(player->getSprite().getGlobalBounds())) {
+                            player->decreaseLife();
+                            bulletIt = bullets.erase(bulletIt);
+                            bulletRemoved = true;
+                            if (player->getLives() <= 0) {
+                                bool flag = gameOverScreen();
+                                if (!flag) restFlag = true;
+                                window.close();
+                                std::cout << "Game Over" << std::endl;
+                            }
+                        }
+                        //If enemy's bullet collide with barrier, it shrinks
+                        if (!bulletRemoved) {
+                            if (barrier1.bulletCollision(bulletIt->getSprite())) {
+                                barrier1.shrink();
+                                bulletIt = bullets.erase(bulletIt);
+                                bulletRemoved = true;
+                                break;
+                            }
+                            if (barrier2.bulletCollision(bulletIt->getSprite())) {
+                                barrier2.shrink();
+                                bulletIt = bullets.erase(bulletIt);
+                                bulletRemoved = true;
+                                break;
+                            }
+                            if (barrier3.bulletCollision(bulletIt->getSprite())) {
+                                barrier3.shrink();
+                                bulletIt = bullets.erase(bulletIt);
+                                bulletRemoved = true;
+                                break;
+                            }
+                        }
+                        if (!bulletRemoved) {
+                            ++bulletIt;
+                        }
+                    }
+                    //Check enemy collides with player
+                    if (enemy.getIsAlive() && player->isCollidingWithEnemy(enemy.getSprite())) {
+                        enemy.kill();
                         player->decreaseLife();
-                        bulletIt = bullets.erase(bulletIt);
-                        bulletRemoved = true;
+                        metrics.updateHealthbar(player->getLives());
+                        //if life is 0, display gameover screen
                         if (player->getLives() <= 0) {
                             bool flag = gameOverScreen();
                             if (!flag) restFlag = true;
@@ -198,47 +290,19 @@ void Game::gameLoop() {
                             std::cout << "Game Over" << std::endl;
                         }
                     }
-                    //If enemy's bullet collide with barrier, it shrinks
-                    if (!bulletRemoved) {
-                        if (barrier1.bulletCollision(bulletIt->getSprite())) {
-                            barrier1.shrink();
-                            bulletIt = bullets.erase(bulletIt);
-                            bulletRemoved = true;
-                            break;
-                        }
-                        if (barrier2.bulletCollision(bulletIt->getSprite())) {
-                            barrier2.shrink();
-                            bulletIt = bullets.erase(bulletIt);
-                            bulletRemoved = true;
-                            break;
-                        }
-                        if (barrier3.bulletCollision(bulletIt->getSprite())) {
-                            barrier3.shrink();
-                            bulletIt = bullets.erase(bulletIt);
-                            bulletRemoved = true;
-                            break;
-                        }
-                    }
-                    if (!bulletRemoved) {
-                        ++bulletIt;
-                    }
-                }
-                //Check enemy collides with player
-                if (enemy.getIsAlive() && player->isCollidingWithEnemy(enemy.getSprite())) {
-                    enemy.kill();
-                    player->decreaseLife();
-                    metrics.updateHealthbar(player->getLives());
-                    //if life is 0, display gameover screen
-                    if (player->getLives() <= 0) {
-                        bool flag = gameOverScreen();
-                        if (!flag) restFlag = true;
-                        window.close();
-                        std::cout << "Game Over" << std::endl;
-                    }
                 }
             }
-        }
 
+            /** when bullet hits barrier, the barrier shrinks */
+            player->updateBarrier(simulationStep, barrier1);
+            player->updateBarrier(simulationStep, barrier2);
+            player->updateBarrier(simulationStep, barrier3);
+        }
+        if (!window.isOpen()) {
+            break;
+        }
+        // How far the frame is into the next tick, every object is drawn that far between its last two ticks
+        float blend = lag / simulationStep;
 
         // display next stage
         time += clock2.restart().asSeconds();
@@ -250,6 +314,9 @@ void Game::gameLoop() {
                 stage++; // Start fading out
                 time = 0; // Reset timer for fade out
                 stageText.setString("Stage: " + std::to_string(metrics.getStage()));
+                // Lay out and re-center the banner here, so snapshot copies carry its finished geometry
+                textRect = stageText.getLocalBounds();
+                stageText.setOrigin(textRect.left + textRect.width / 2.0f, textRect.top + textRect.height / 2.0f);
                 if (metrics.getStage() >= 1) {
                     barrier1.reset();
                     barrier2.reset();
@@ -268,39 +335,57 @@ void Game::gameLoop() {
         stageText.setFillColor(sf::Color(stageText.getFillColor().r, stageText.getFillColor().g, stageText.getFillColor().b, static_cast<sf::Uint8>(alpha)));
 
 
-        /** when bullet hits barrier, the barrier shrinks */
-        player->updateBarrier(deltaTime, barrier1);
-        player->updateBarrier(deltaTime, barrier2);
-        player->updateBarrier(deltaTime, barrier3);
-        enemyWave->draw(window);
-        /** end of enemy stuff */
+        // With a render thread, the frame is handed over as a snapshot and the next one simulated while it is drawn
+        if (options.isRenderThreaded()) {
+            renderThread.start(window, [this](const RenderSnapshot& frame) { drawSnapshot(frame); });
+            RenderSnapshot& frame = renderThread.acquire();
+            captureFrame(frame, blend);
+            frame.shapes.push_back(roundedRect);
+            frame.texts.push_back(stageText);
+            culledObjects = frame.scene.getCulledCount();
+            culledTotal += culledObjects;
+            culledMost = std::max(culledMost, culledObjects);
+            ++frames;
+            renderThread.publish();
+            continue;
+        }
 
-        window.clear();
-        player->draw(window);
-        powerup.draw(window,player);
-        player->drawBullets(window);
-        enemyWave->draw(window);
-        barrier1.draw(window);
-        barrier2.draw(window);
-        barrier3.draw(window);
-        metrics.draw(window);
+        // The world is drawn at the dynamic resolution, the HUD and the stage banner at native resolution
+        sceneScaler.update(deltaTime);
+        drawWorld(window, blend);
+        culledTotal += culledObjects;
+        culledMost = std::max(culledMost, culledObjects);
+        ++frames;
         window.draw(roundedRect);
         window.draw(stageText);
+        capture.grab(window);
         window.display();
+        pacer.wait();
+    }
+    renderThread.stop();
+    capture.stopRecording();
+    pacer.printReport("Gameplay");
+    capture.finish();
+    capture.printReport("Gameplay");
+    if (frames > 0) {
+        std::cout << "--- Culling: " << static_cast<double>(culledTotal) / frames << " objects per frame on average, "
+                  << culledMost << " at most" << std::endl;
     }
     // check of user wants to replay the game
     if (restFlag) {
         sf::VideoMode fullScreenMode = sf::VideoMode::getDesktopMode();
         window.create((options.isFullScreen()) ? fullScreenMode : sf::VideoMode(options.getResolution()[0],options.getResolution()[1]), "Fire Fighter", (options.isFullScreen() || options.getResolution()[0] >= fullScreenMode.width) ? sf::Style::Fullscreen : sf::Style::Default);
         window.setIcon(icon.getSize().x, icon.getSize().y, icon.getPixelsPtr()); // Set the window icon
-        window.setFramerateLimit(60);
+        configurePacing();
+        applyResolution(window.getSize());
         metrics.reset();
         barrier1.reset();
         barrier2.reset();
         barrier3.reset();
         powerup.reset();
-        player->reset(window);
+        player->reset();
         enemyWave->respawnEnemies(1);
+        SceneManager::getInstance().enterScene(Scene::Gameplay, options.getVector());
         goto spetsnaz;
     }
 }
@@ -309,26 +394,19 @@ void Game::gameLoop() {
 /**
  * Displays the character selection screen and processes user input.
  *
- * @return char* A string containing the file path of the selected character's texture. Returns NULL if the user exits.
+ * @return char* A string containing the asset id of the selected character's texture. Returns NULL if the user exits.
  * @author Robert Andrew Biernacki
  */
 char* Game::characterSelectScreen() {
     char* str;                                          // String of player texture path to return
-    sf::Texture boyTexture;                             // load image of the boy droplet image
-    sf::Texture girlTexture;                            // load image of the girl droplet image
-    sf::Texture characterBackDropTexture;               // load image of the backdrop of the characters
-    if (!boyTexture.loadFromFile("../../resource/img/waterBoy.png")) {
-        std::cerr << "Failed to load player!" << std::endl;
-    }
-    if (!girlTexture.loadFromFile("../../resource/img/waterGirl.png")) {
-        std::cerr << "Failed to load player!" << std::endl;
-    }
-    if (!characterBackDropTexture.loadFromFile("../../resource/img/character_back_drop.png")) {
-        std::cerr << "Failed to load backdrop!" << std::endl;
-    }
-    sf::Sprite boyDroplet(boyTexture);          // sprite of the boy player
-    sf::Sprite girlDroplet(girlTexture);        // sprite of the girl player
-    sf::Sprite characterBackDrop(characterBackDropTexture); // sprites of the backdrop
+    SceneManager::getInstance().enterScene(Scene::CharacterSelect, options.getVector());    // load the images of this screen once
+    TextureCache& cache = TextureCache::getInstance();  // images were decoded by the preloader while the menu was shown
+    auto boyTexture = cache.acquire("resource/img/waterBoy.png");                           // image of the boy droplet
+    auto girlTexture = cache.acquire("resource/img/waterGirl.png");                         // image of the girl droplet
+    auto characterBackDropTexture = cache.acquire("resource/img/character_back_drop.png");  // image of the backdrop of the characters
+    sf::Sprite boyDroplet(*boyTexture);          // sprite of the boy player
+    sf::Sprite girlDroplet(*girlTexture);        // sprite of the girl player
+    sf::Sprite characterBackDrop(*characterBackDropTexture); // sprites of the backdrop
     boyDroplet.setScale(options.widthScaling(3), options.heightScaling(3));
     girlDroplet.setScale(options.widthScaling(3), options.heightScaling(3));
     characterBackDrop.setScale(options.widthScaling(3), options.heightScaling(3));
@@ -344,7 +422,7 @@ char* Game::characterSelectScreen() {
     selectBoyButton.setOutlineThickness(2);
     selectBoyButton.setOutlineColor(sf::Color::White);
     // Create boy select button text
-    sf::Text text1(options.getLanguage()[16], font, options.widthScaling(28));
+    TextLabel text1(options.getLanguage()[16], *font, options.widthScaling(28));
     text1.setPosition(selectBoyButton.getPosition().x + (selectBoyButton.getSize().x - text1.getLocalBounds().width) / 2, selectBoyButton.getPosition().y + (selectBoyButton.getSize().y - text1.getLocalBounds().height) / 2);
     text1.setFillColor(sf::Color(235, 70, 60));
     // Create girl select button
@@ -354,7 +432,7 @@ char* Game::characterSelectScreen() {
     selectGirlButton.setOutlineThickness(2);
     selectGirlButton.setOutlineColor(sf::Color::White);
     // Create girl select button text
-    sf::Text text2(options.getLanguage()[15], font, options.widthScaling(28));
+    TextLabel text2(options.getLanguage()[15], *font, options.widthScaling(28));
     text2.setPosition(selectGirlButton.getPosition().x + (selectGirlButton.getSize().x - text2.getLocalBounds().width) / 2, selectGirlButton.getPosition().y + (selectGirlButton.getSize().y - text2.getLocalBounds().height) / 2);
     text2.setFillColor(sf::Color(235, 70, 60));
 
@@ -363,7 +441,7 @@ char* Game::characterSelectScreen() {
     girlDroplet.setPosition((selectGirlButton.getPosition().x + (selectGirlButton.getGlobalBounds().width/2) - (girlDroplet.getGlobalBounds().width/2)), selectGirlButton.getPosition().y - (girlDroplet.getGlobalBounds().height * 1.5));
 
     // create text at top of screen
-    sf::Text chooseText(options.getLanguage()[13], font, options.widthScaling(70));
+    TextLabel chooseText(options.getLanguage()[13], *font, options.widthScaling(70));
     chooseText.setPosition((screenWidth - chooseText.getLocalBounds().width) / 2, 50); // Position text at the top center
     chooseText.setFillColor(sf::Color(235, 70, 60));
     // Create "Go Back" button
@@ -373,15 +451,16 @@ char* Game::characterSelectScreen() {
     backButton.setOutlineThickness(2);
     backButton.setOutlineColor(sf::Color::White);
     // create go back text on go back button
-    sf::Text backText(options.getLanguage()[14], font, options.widthScaling(28));
+    TextLabel backText(options.getLanguage()[14], *font, options.widthScaling(28));
     backText.setPosition(backButton.getPosition().x + (backButton.getSize().x - backText.getLocalBounds().width) / 2, backButton.getPosition().y + (backButton.getSize().y - backText.getLocalBounds().height) / 2);
     backText.setFillColor(sf::Color(235, 70, 60));
 
     bool hoverFlagBoy = false;          // flag to know when to display backdrop for boy
     bool hoverFlagGirl = false;         // flag to know when to display backdrop for girl
+    MenuEventQueue events(window);      // the screen only changes on input, so it is only redrawn then
     for (int flag = true; flag;) {
         sf::Event event;
-        while (window.pollEvent(event)) {
+        while (events.poll(event)) {
             if (event.type == sf::Event::Closed) {
                 window.close();
                 return NULL;
@@ -392,14 +471,14 @@ char* Game::characterSelectScreen() {
                     if (selectBoyButton.getGlobalBounds().contains(mousePos)) {
                         // boy select Button clicked
                         std::cout << "Player 1 selected\n";
-                        str = "../../resource/img/waterBoy.png";
+                        str = "resource/img/waterBoy.png";
                         flag = false;
 
                     }
                     if (selectGirlButton.getGlobalBounds().contains(mousePos)) {
                         // girl select Button  clicked
                         std::cout << "Player 2 selected\n";
-                        str = "../../resource/img/waterGirl.png";
+                        str = "resource/img/waterGirl.png";
                         flag = false;
                     }
                     if (backButton.getGlobalBounds().contains(mousePos)) {
@@ -460,6 +539,10 @@ char* Game::characterSelectScreen() {
 
         // Display the window
         window.display();
+        pacer.wait();
+        if (flag) {
+            events.wait();  // sleep until the next input
+        }
     }
     return str;
 }
@@ -471,6 +554,8 @@ char* Game::characterSelectScreen() {
  * @author Robert Andrew Biernacki
  */
 bool Game::handleExitRequest() {
+    renderThread.stop();    // the screen draws on this thread
+    SceneManager::getInstance().enterScene(Scene::Pause, options.getVector());
     // Calculate button sizes and positions dynamically based on window size
     float buttonWidth = options.widthScaling(resolution.x * 0.25f);
     float buttonHeight = options.heightScaling(50.f);
@@ -490,16 +575,16 @@ bool Game::handleExitRequest() {
     resumeButton.setOutlineColor(sf::Color::White);
 
     // Setup the text for buttons
-    sf::Text exitText;
-    exitText.setFont(font);
+    TextLabel exitText;
+    exitText.setFont(*font);
     exitText.setString(options.getLanguage()[20]);
     exitText.setCharacterSize(options.widthScaling(24));
     exitText.setFillColor(sf::Color::White);
     // Center text on its button
     exitText.setPosition(buttonX + (buttonWidth - exitText.getLocalBounds().width) / 2, exitButtonY + (buttonHeight - exitText.getLocalBounds().height) / 2);
 
-    sf::Text resumeText;
-    resumeText.setFont(font);
+    TextLabel resumeText;
+    resumeText.setFont(*font);
     resumeText.setString(options.getLanguage()[21]);
     resumeText.setCharacterSize(options.widthScaling(24));
     resumeText.setFillColor(sf::Color::White);
@@ -510,9 +595,10 @@ bool Game::handleExitRequest() {
     sf::Color normalColor(100, 100, 100); // Normal state color
     sf::Color hoverColor(150, 150, 150);  // Hover state color
 
+    MenuEventQueue events(window);      // the screen only changes on input, so it is only redrawn then
     while (window.isOpen()) {
         sf::Event event;
-        while (window.pollEvent(event)) {
+        while (events.poll(event)) {
             if (event.type == sf::Event::Closed) {
                 return false;
             }
@@ -542,22 +628,167 @@ bool Game::handleExitRequest() {
         else
             resumeButton.setFillColor(normalColor);
 
+        // The paused game is drawn in the virtual space, the buttons in window pixels
+        window.setView(worldView);
         window.clear();
         metrics.draw(window);
         player->draw(window);
         powerup.draw(window,player);
-        player->drawBullets(window);
         enemyWave->draw(window);
+        drawProjectiles(window);
         barrier1.draw(window);
         barrier2.draw(window);
         barrier3.draw(window);
+        window.setView(sf::View(sf::FloatRect(0.f, 0.f, window.getSize().x, window.getSize().y)));
         window.draw(exitButton);
         window.draw(exitButton);
         window.draw(exitText);
         window.draw(resumeButton);
         window.draw(resumeText);
         window.display();
+        screenPacer.wait(); // keep bursts of input from redrawing faster than the frame rate
+        events.wait();      // sleep until the next input
+    }
+}
+
+/**
+ * Applies the frame rate and vertical sync of the settings to the window.
+ */
+void Game::configurePacing() {
+    pacer.configure(window, options.getFrameRate(), options.isVsync());
+    screenPacer.configure(window, options.getFrameRate(), options.isVsync());
+    sf::Time target = pacer.getTargetFrameTime();
+    sceneScaler.setTargetFrameTime(target != sf::Time::Zero ? target : sf::seconds(1.f / 60.f));
+}
+
+/**
+ * Fits the game to a new window size.
+ * @param windowSize The size of the window in pixels.
+ */
+void Game::applyResolution(sf::Vector2u windowSize) {
+    worldView = VirtualView::letterbox(windowSize);
+    pixelDensity = VirtualView::getDensity(windowSize);
+    sceneScaler.create(windowSize);
+
+    // Move the sprites to the atlas built for the new density, so they are drawn 1:1 again. Most
+    // resize events keep the rounded density and the atlas, so nothing is resampled for them.
+    float atlasDensity = VirtualView::getPixelDensity();
+    VirtualView::setPixelDensity(pixelDensity);
+    metrics.setPixelDensity(pixelDensity);
+    if (VirtualView::getPixelDensity() == atlasDensity) {
+        return;
+    }
+    barrier1.reloadTexture();
+    barrier2.reloadTexture();
+    barrier3.reloadTexture();
+    powerup.reloadTexture();
+    if (player != nullptr) {
+        player->reloadTexture();
+    }
+    if (enemyWave != nullptr) {
+        enemyWave->reloadTextures();
+    }
+    // Drop the atlas of the old density, unless bullets in flight still use it, then a later purge does
+    TextureCache::getInstance().purge();
+}
+
+/**
+ * Draws every player and enemy bullet with one batch.
+ * @param target The target to draw the bullets to.
+ */
+void Game::drawProjectiles(sf::RenderTarget& target, float alpha) {
+    projectileBatch.clear();
+    projectileBatch.setVisibleArea(VirtualView::getVisibleArea(target.getView()));
+    player->addBulletsTo(projectileBatch, alpha);
+    enemyWave->addBulletsTo(projectileBatch, alpha);
+    target.draw(projectileBatch);
+}
+
+/**
+ * Draws the gameplay world at the dynamic resolution and the HUD over it.
+ * @param target The window or the off-screen canvas, cleared first.
+ * @param alpha How far the frame is between the last simulation tick and the next one, from 0 to 1.
+ */
+void Game::drawWorld(sf::RenderTarget& target, float alpha) {
+    target.setView(worldView);
+    target.clear();
+    sf::RenderTarget& scene = sceneScaler.begin(target);
+    player->draw(scene, alpha);
+    powerup.draw(scene, player, alpha);
+    enemyWave->draw(scene, alpha);
+    drawProjectiles(scene, alpha);
+    barrier1.draw(scene);
+    barrier2.draw(scene);
+    barrier3.draw(scene);
+    sceneScaler.present(target);
+    culledObjects = enemyWave->getCulledCount() + projectileBatch.getCulledCount();
+    metrics.draw(target);
+}
+
+/**
+ * Places the barriers in front of the player, in the virtual space.
+ */
+void Game::placeBarriers() {
+    const sf::Vector2f area = VirtualView::getSize();
+    float useableHeight = area.y - (area.y * 0.1f);
+    barrier1.setPosition(area.x * 0.83f, useableHeight * 0.25f);
+    barrier2.setPosition(area.x * 0.83f, useableHeight * 0.55f);
+    barrier3.setPosition(area.x * 0.83f, useableHeight * 0.85f);
+}
+
+/**
+ * Copies the gameplay world and the HUD of the frame into a snapshot for the render thread.
+ *
+ * @param frame The snapshot to fill, cleared first.
+ * @param alpha How far the frame is between the last simulation tick and the next one, from 0 to 1.
+ */
+void Game::captureFrame(RenderSnapshot& frame, float alpha) {
+    frame.clear();
+    frame.scene.setVisibleArea(VirtualView::getVisibleArea(worldView));
+    frame.scene.add(player->getInterpolatedSprite(alpha));
+    powerup.addTo(frame.scene, player, alpha);
+    enemyWave->addEnemiesTo(frame.scene, alpha);
+    player->addBulletsTo(frame.scene, alpha);
+    enemyWave->addBulletsTo(frame.scene, alpha);
+    barrier1.addTo(frame.scene);
+    barrier2.addTo(frame.scene);
+    barrier3.addTo(frame.scene);
+    metrics.capture(frame);
+}
+
+/**
+ * Draws a snapshot of a frame to the window and displays it, on the render thread.
+ *
+ * @param frame The snapshot to draw.
+ */
+void Game::drawSnapshot(const RenderSnapshot& frame) {
+    sceneScaler.update(pacer.getLastFrameTime());
+    window.setView(worldView);
+    window.clear();
+    sf::RenderTarget& scene = sceneScaler.begin(window);
+    scene.draw(frame.scene);
+    sceneScaler.present(window);
+    for (const auto& shape : frame.shapes) {
+        window.draw(shape);
+    }
+    for (const auto& sprite : frame.sprites) {
+        window.draw(sprite);
     }
+    for (const auto& text : frame.texts) {
+        window.draw(text);
+    }
+    capture.grab(window);
+    window.display();
+    pacer.wait();
+}
+
+/**
+ * Records where every moving object is before a simulation tick moves it.
+ */
+void Game::recordPositions() {
+    player->recordPositions();
+    enemyWave->recordPositions();
+    powerup.recordPosition();
 }
 
 /**
@@ -567,6 +798,8 @@ bool Game::handleExitRequest() {
  * @author Robert Andrew Biernacki
  */
 bool Game::gameOverScreen() {
+    renderThread.stop();    // the screen draws on this thread
+    SceneManager::getInstance().enterScene(Scene::GameOver, options.getVector());
     // Get the screen dimensions
     float screenWidth = static_cast<float>(window.getSize().x);
     float screenHeight = static_cast<float>(window.getSize().y);
@@ -584,18 +817,18 @@ bool Game::gameOverScreen() {
     resumeButton.setOutlineColor(sf::Color::White);
 
     // Create exit game button text
-    sf::Text exitText(options.getLanguage()[17], font, options.widthScaling(28));
+    TextLabel exitText(options.getLanguage()[17], *font, options.widthScaling(28));
     exitText.setPosition(exitButton.getPosition().x + (exitButton.getSize().x - exitText.getLocalBounds().width) / 2, exitButton.getPosition().y + (exitButton.getSize().y - exitText.getLocalBounds().height) / 2);
     exitText.setFillColor(sf::Color(235, 70, 60));
 
     // Create resume button text
-    sf::Text resumeText(options.getLanguage()[18], font, options.widthScaling(28));
+    TextLabel resumeText(options.getLanguage()[18], *font, options.widthScaling(28));
     resumeText.setPosition(resumeButton.getPosition().x + (resumeButton.getSize().x - resumeText.getLocalBounds().width) / 2, resumeButton.getPosition().y + (resumeButton.getSize().y - resumeText.getLocalBounds().height) / 2);
     resumeText.setFillColor(sf::Color(235, 70, 60));
 
     // Create a Game Over Text
-    sf::Text gameOverText;
-    gameOverText.setFont(font); // Set the font to our loaded font
+    TextLabel gameOverText;
+    gameOverText.setFont(*font); // Set the font to our loaded font
     gameOverText.setString(options.getLanguage()[19]); // Set the gameOverText string
     gameOverText.setCharacterSize(options.widthScaling(48)); // Set the gameOverText size
     gameOverText.setFillColor(sf::Color::Red); // Set the gameOverText color
@@ -607,9 +840,10 @@ bool Game::gameOverScreen() {
     sf::Color normalColor(100, 100, 100); // Normal state color
     sf::Color hoverColor(150, 150, 150);  // Hover state color
 
+    MenuEventQueue events(window);      // the screen only changes on input, so it is only redrawn then
     while (window.isOpen()) {
         sf::Event event;
-        while (window.pollEvent(event)) {
+        while (events.poll(event)) {
             if (event.type == sf::Event::Closed) {
                 return false;
             }
@@ -646,7 +880,105 @@ bool Game::gameOverScreen() {
         window.draw(resumeButton); // Draw the resume button shape
         window.draw(resumeText); // Draw the resume button gameOverText
         window.draw(gameOverText);
+        window.setView(worldView);          // the final score is laid out in the virtual space
         metrics.drawFinalScore(window);
+        window.setView(sf::View(sf::FloatRect(0.f, 0.f, window.getSize().x, window.getSize().y)));
         window.display();
+        screenPacer.wait(); // keep bursts of input from redrawing faster than the frame rate
+        events.wait();      // sleep until the next input
+    }
+}
+
+/**
+ * Runs the headless benchmark and prints its frame times.
+ *
+ * @return bool True if every frame was drawn and saved, false otherwise.
+ */
+bool Game::runHeadless() {
+    if (!canvas.create(headless.size.x, headless.size.y)) {
+        std::cerr << "Failed to create the off-screen canvas" << std::endl;
+        return false;
+    }
+    char playerTexture[] = "resource/img/waterBoy.png";
+    player->setPlayerTexture(playerTexture);
+    SceneManager::getInstance().enterScene(Scene::Gameplay, options.getVector());
+    placeBarriers();
+    metrics.setEnemyCount(enemyWave->getTotalSpawned());
+
+    const sf::Vector2f area = VirtualView::getSize();
+    const float metricsBarHeight = area.y * 0.1f;
+    const float movementStep = player->getMovementSpeed() * simulationStep.asSeconds();
+    const sf::Time frameTime = sf::seconds(1.f / 60.f);    // simulated, so every run draws the same frames
+    sf::Time lag = sf::Time::Zero;
+    unsigned tick = 0;
+    float direction = -1.f;     // the player patrols up and down
+    bool saved = true;
+
+    pacer.resetStatistics();
+    for (unsigned frame = 0; frame < headless.frames; ++frame) {
+        lag += frameTime;
+        while (lag >= simulationStep) {
+            lag -= simulationStep;
+            recordPositions();
+            float next = player->getPosition().y + direction * movementStep;
+            if (next < metricsBarHeight || next + player->getSize().y > area.y) {
+                direction = -direction;
+            }
+            player->move(sf::Vector2f(0.f, direction), simulationStep);
+            if (tick % 15 == 0) {
+                player->shoot();    // as often as the cooldown of the game allows
+            }
+
+            // The front enemy of every row shoots once every two seconds, one row after the other
+            for (int i = 0; i < enemyWave->getRows(); ++i) {
+                for (int j = 0; j < enemyWave->getColumns(); ++j) {
+                    Enemy& enemy = enemyWave->getEnemy(i, j);
+                    enemy.update(simulationStep);
+                    bool hasEnemyOnRight = (j < enemyWave->getColumns() - 1) && enemyWave->getEnemy(i, j + 1).getIsAlive();
+                    if (!hasEnemyOnRight && enemy.getIsAlive() && tick % 60 == static_cast<unsigned>(i) * 12) {
+                        enemy.shoot();
+                    }
+                }
+            }
+
+            metrics.updateHealthbar(player->getLives());
+            player->updateBullets(simulationStep, *enemyWave, metrics);
+            if (enemyWave->allEnemiesDead()) {
+                enemyWave->respawnEnemies(0);
+            }
+            enemyWave->update(metricsBarHeight, simulationStep);
+            player->updateBarrier(simulationStep, barrier1);
+            player->updateBarrier(simulationStep, barrier2);
+            player->updateBarrier(simulationStep, barrier3);
+            ++tick;
+        }
+
+        drawWorld(canvas, lag / simulationStep);
+        canvas.display();
+        pacer.wait();
+        if (headless.dumpEvery > 0 && frame % headless.dumpEvery == 0) {
+            saved = dumpFrame(frame) && saved;
+            pacer.restartFrame();   // reading back and encoding the image is not part of the frame
+        }
+    }
+    pacer.printReport("Headless " + std::to_string(headless.size.x) + "x" + std::to_string(headless.size.y));
+    return saved;
+}
+
+/**
+ * Saves the canvas as a numbered PNG image in the dump directory of the headless benchmark.
+ *
+ * @param frame Number of the frame, part of the file name.
+ * @return True if the image was saved, false otherwise.
+ */
+bool Game::dumpFrame(unsigned frame) {
+    std::error_code error;
+    std::filesystem::create_directories(headless.dumpDirectory, error);
+    std::ostringstream path;
+    path << headless.dumpDirectory << "/frame_" << std::setw(5) << std::setfill('0') << frame << ".png";
+    if (!canvas.getTexture().copyToImage().saveToFile(path.str())) {
+        std::cerr << "Failed to save " << path.str() << std::endl;
+        return false;
     }
+    return true;
 }
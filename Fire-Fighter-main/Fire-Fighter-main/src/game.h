@@ -11,15 +11,29 @@
 #include "barrier.h"
 #include "metrics.h"
 #include "enemywave.h"
+#include "preloader.h"
+#include "texturecache.h"
+#include "scenemanager.h"
+#include "musicservice.h"
+#include "spritebatch.h"
+#include "textlayoutcache.h"
+#include "menueventqueue.h"
+#include "dynamicresolution.h"
+#include "virtualview.h"
+#include "framepacer.h"
+#include "renderthread.h"
+#include "headlessoptions.h"
+#include "framecapture.h"
 
 
 class Game {
 private:
+    static const sf::Time simulationStep; ///< Duration of a simulation tick, the game simulates at a fixed 30 Hz.
+
     sf::RenderWindow window; ///< Main game window where all graphics are rendered.
     Settings options; ///< Game settings including graphics, sound, and user preferences.
-    sf::Font font; ///< Global font used for text elements in the game.
+    const sf::Font* font; ///< Global font used for text elements in the game, shared through the FontService.
     sf::Image icon; ///< Icon for the game window.
-    sf::Music music; ///< Background music player.
     sf::Vector2u resolution; ///< Resolution of the game window, derived from settings.
     sf::Clock clock; ///< Clock for managing updates and timing in the game loop.
     Metrics metrics; ///< Game metrics such as score and health.
@@ -27,6 +41,94 @@ private:
     Powerup powerup; ///< Powerup object for granting player enhancements or bonuses.
     Player* player; ///< Player-controlled character.
     EnemyWave* enemyWave; ///< Management of enemy waves and behavior.
+    SpriteBatch projectileBatch; ///< Player and enemy bullets of the frame, drawn together.
+    DynamicResolution sceneScaler; ///< Internal resolution of the gameplay world, adapted to the frame time.
+    sf::View worldView; ///< View showing the virtual space of the game in the window.
+    float pixelDensity; ///< Number of window pixels per virtual unit.
+    FramePacer pacer; ///< Paces the frames of the game and its screens at the configured frame rate.
+    FramePacer screenPacer; ///< Paces the pause and game over screens, whose idle time must not count as gameplay frames.
+    std::size_t culledObjects = 0; ///< Number of enemies and bullets outside of the view, not drawn in the last frame.
+    FrameCapture capture; ///< Screenshots (F11) and recordings (F12, Shift+F12 for raw frames) of the game.
+    RenderThread renderThread; ///< Draws the frames while the next one is simulated, if enabled in the settings.
+    HeadlessOptions headless; ///< Options of the headless benchmark, disabled for a normal game.
+    sf::RenderTexture canvas; ///< Target of the frames of the headless benchmark, instead of the window.
+
+    /**
+     * @brief Draws every player and enemy bullet.
+     *
+     * All bullets are collected into one SpriteBatch. Both bullet sprites live in the gameplay atlas,
+     * so every bullet on screen is drawn with a single draw call. Bullets outside of the view are culled.
+     *
+     * @param target The target to draw the bullets to.
+     * @param alpha How far the frame is between the last simulation tick and the next one, from 0 to 1.
+     */
+    void drawProjectiles(sf::RenderTarget& target, float alpha = 1.f);
+
+    /**
+     * @brief Draws the gameplay world at the dynamic resolution and the HUD over it.
+     *
+     * Both the game and the headless benchmark draw their frames with it.
+     *
+     * @param target The window or the off-screen canvas, cleared first.
+     * @param alpha How far the frame is between the last simulation tick and the next one, from 0 to 1.
+     */
+    void drawWorld(sf::RenderTarget& target, float alpha);
+
+    /**
+     * @brief Places the barriers in front of the player.
+     */
+    void placeBarriers();
+
+    /**
+     * @brief Saves the canvas as a numbered PNG image in the dump directory of the headless benchmark.
+     *
+     * @param frame Number of the frame, part of the file name.
+     * @return True if the image was saved, false otherwise.
+     */
+    bool dumpFrame(unsigned frame);
+
+    /**
+     * @brief Records where every moving object is at the start of a simulation tick.
+     *
+     * The simulation runs at a fixed tick rate lower than the frame rate. Frames draw every object
+     * between the recorded position and the one the tick moves it to, so motion stays smooth.
+     */
+    void recordPositions();
+
+    /**
+     * @brief Copies the gameplay world and the HUD of the frame into a snapshot for the render thread.
+     *
+     * @param frame The snapshot to fill, cleared first.
+     * @param alpha How far the frame is between the last simulation tick and the next one, from 0 to 1.
+     */
+    void captureFrame(RenderSnapshot& frame, float alpha);
+
+    /**
+     * @brief Draws a snapshot of a frame to the window and displays it, on the render thread.
+     *
+     * Only the render thread uses the window, the view, the dynamic resolution and the pacer while it runs.
+     *
+     * @param frame The snapshot to draw.
+     */
+    void drawSnapshot(const RenderSnapshot& frame);
+
+    /**
+     * @brief Fits the game to a new window size.
+     *
+     * The game runs in the virtual space whatever the window size, so this only replaces the view,
+     * recreates the scene layer, rasterizes the HUD and acquires the sprites from the atlas for the
+     * new pixel density.
+     *
+     * @param windowSize The size of the window in pixels.
+     */
+    void applyResolution(sf::Vector2u windowSize);
+
+    /**
+     * @brief Applies the frame rate and vertical sync of the settings to the window.
+     *
+     * The dynamic resolution aims for the same frame time, or 60 FPS if the frame rate is uncapped.
+     */
+    void configurePacing();
 
 
 public:
@@ -43,6 +145,17 @@ public:
  */
     explicit Game(Settings *opt);
 
+    /**
+ * @brief Constructs the Game object for the headless benchmark.
+ *
+ * No window is opened; the frames are drawn into an off-screen canvas of the size in the options,
+ * see runHeadless().
+ *
+ * @param opt A pointer to the Settings object containing game settings.
+ * @param headless The options of the benchmark.
+ */
+    Game(Settings *opt, const HeadlessOptions& headless);
+
     /**
  * @brief Destroys the Game object.
  *
@@ -72,7 +185,7 @@ public:
  * Handles user interactions for selecting a character or exiting back to the main UI.
  * It loads and displays character sprites and updates the game state based on the selection.
  *
- * @return char* A string containing the file path of the selected character's texture. Returns NULL if the user exits.
+ * @return char* A string containing the asset id of the selected character's texture. Returns NULL if the user exits.
  * @author Robert Andrew Biernacki
  */
     char* characterSelectScreen();
@@ -99,6 +212,18 @@ public:
  * @author Robert Andrew Biernacki
  */
     bool gameOverScreen();
+
+    /**
+ * @brief Runs the headless benchmark and prints its frame times.
+ *
+ * Plays a scripted game, the same in every run, into the off-screen canvas for the number of frames
+ * in the options. The player moves up and down and shoots, the enemies shoot in turns and nobody can
+ * lose. Frames are simulated as if they were 1/60 s apart, and the internal resolution is kept at
+ * its maximum, so every run draws exactly the same frames and saved frames can be compared between builds.
+ *
+ * @return bool True if every frame was drawn and saved, false otherwise.
+ */
+    bool runHeadless();
 };
 
 #endif //FIRE_FIGHTER_GAME_H
@@ -0,0 +1,61 @@
+#include "headlessoptions.h"
+#include <iostream>
+
+/**
+ * Read a positive number from the argument following an option.
+ * @param text The argument.
+ * @param value Set to the number if the argument is one.
+ * @return True if the argument is a number greater than 0.
+ */
+bool HeadlessOptions::readCount(const std::string& text, unsigned& value) {
+    try {
+        std::size_t end = 0;
+        unsigned long number = std::stoul(text, &end);
+        if (end != text.size() || number == 0) {
+            return false;
+        }
+        value = static_cast<unsigned>(number);
+        return true;
+    } catch (const std::exception&) {
+        return false;
+    }
+}
+
+/**
+ * Read the options of the headless benchmark from the command line.
+ * @param argc Number of arguments.
+ * @param argv The arguments, argv[0] is the program.
+ * @return True if the arguments are valid, false if one could not be read.
+ */
+bool HeadlessOptions::parse(int argc, char* argv[]) {
+    for (int i = 1; i < argc; ++i) {
+        std::string option = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (option == "--headless") {
+            enabled = true;
+        } else if (option == "--frames" && hasValue) {
+            if (!readCount(argv[++i], frames)) {
+                std::cerr << "--frames needs a number of frames greater than 0" << std::endl;
+                return false;
+            }
+        } else if (option == "--dump-every" && hasValue) {
+            if (!readCount(argv[++i], dumpEvery)) {
+                std::cerr << "--dump-every needs a number of frames greater than 0" << std::endl;
+                return false;
+            }
+        } else if (option == "--dump-dir" && hasValue) {
+            dumpDirectory = argv[++i];
+        } else if (option == "--size" && hasValue) {
+            std::string size = argv[++i];
+            std::size_t x = size.find('x');
+            if (x == std::string::npos || !readCount(size.substr(0, x), this->size.x) || !readCount(size.substr(x + 1), this->size.y)) {
+                std::cerr << "--size needs a frame size like 1280x720" << std::endl;
+                return false;
+            }
+        } else {
+            std::cerr << "Unknown option " << option << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,47 @@
+/**
+ * @file headlessoptions.h
+ * @brief Declaration of the HeadlessOptions struct.
+ */
+
+#ifndef FIRE_FIGHTER_HEADLESSOPTIONS_H
+#define FIRE_FIGHTER_HEADLESSOPTIONS_H
+
+#include <SFML/System.hpp>
+#include <string>
+
+/**
+ * @struct HeadlessOptions
+ * @brief Command line options of the headless rendering benchmark.
+ *
+ * Started with --headless, the game opens no window. It plays a scripted game into an off-screen
+ * render texture for a fixed number of frames and prints the frame times, so changes to the drawing
+ * code can be measured on build machines without a display (Mesa llvmpipe or Xvfb). Every Nth frame
+ * can be saved as a PNG image to compare the output of two builds.
+ *
+ *     CMakeSFMLProject --headless [--frames N] [--dump-every N] [--dump-dir DIR] [--size WxH]
+ */
+struct HeadlessOptions {
+    bool enabled = false; ///< Flag indicating whether --headless was given.
+    unsigned frames = 600; ///< Number of frames to render.
+    unsigned dumpEvery = 0; ///< Save every Nth frame as a PNG image, 0 to save none.
+    std::string dumpDirectory = "."; ///< Directory the images are saved to, created if it does not exist.
+    sf::Vector2u size = sf::Vector2u(1280, 720); ///< Size of the frames in pixels.
+
+    /**
+     * @brief Reads the options from the command line.
+     * @param argc Number of arguments.
+     * @param argv The arguments, argv[0] is the program.
+     * @return True if the arguments are valid, false if one could not be read.
+     */
+    bool parse(int argc, char* argv[]);
+
+    /**
+     * @brief Reads a positive number from the argument following an option.
+     * @param text The argument.
+     * @param value Set to the number if the argument is one.
+     * @return True if the argument is a number greater than 0.
+     */
+    static bool readCount(const std::string& text, unsigned& value);
+};
+
+#endif //FIRE_FIGHTER_HEADLESSOPTIONS_H
@@ -0,0 +1,413 @@
+#include "imagecache.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+/**
+ * Private constructor of the ImageCache, creates the cache directory if needed.
+ * @param directory Path of the cache directory.
+ */
+ImageCache::ImageCache(const std::string& directory) : directory(directory), enabled(true) {
+    std::error_code error;
+    std::filesystem::create_directories(directory, error);
+    if (error) {
+        std::cerr << "Image cache disabled, could not create " << directory << std::endl;
+        enabled = false;
+        return;
+    }
+    removeStaleEntries();   // no other thread can use the cache before it is constructed
+}
+
+/**
+ * Return the cache shared by the whole process.
+ * @return Reference to the image cache.
+ */
+ImageCache& ImageCache::getInstance() {
+    static ImageCache instance("cache/images/");
+    return instance;
+}
+
+/**
+ * Load an image, reading the decoded pixels from the cache when they are up to date.
+ * @param id The asset id of the image.
+ * @param image The image to fill.
+ * @param targetSize Size to scale the image to, or 0x0 to keep the size of the source.
+ * @return True if the image was loaded, false otherwise.
+ */
+bool ImageCache::load(const std::string& id, sf::Image& image, sf::Vector2u targetSize) {
+    sf::Clock clock;
+    std::string key;
+    bool cacheable = enabled && makeKey(id, targetSize, key);
+    if (cacheable && read(key, image)) {
+        LoadReport::getInstance().record(LoadReport::CachedImage, id, clock.getElapsedTime(),
+                                         static_cast<std::size_t>(image.getSize().x) * image.getSize().y * 4, image.getSize());
+        return true;
+    }
+
+    sf::Image decoded;
+    if (!AssetPack::getInstance().load(id, decoded)) {
+        return false;
+    }
+    if (targetSize.x > 0 && targetSize.y > 0 && decoded.getSize() != targetSize) {
+        resample(decoded, targetSize, image);
+    } else {
+        image = decoded;
+    }
+    if (cacheable) {
+        write(key, image);
+    }
+    LoadReport::getInstance().record(LoadReport::Image, id, clock.getElapsedTime(),
+                                     static_cast<std::size_t>(image.getSize().x) * image.getSize().y * 4, image.getSize());
+    return true;
+}
+
+/**
+ * Scale an image by averaging the source pixels each target pixel covers.
+ * @param source The image to scale.
+ * @param size The size of the scaled image.
+ * @param result The image receiving the scaled pixels.
+ * @param smooth True to blend neighbouring pixels when enlarging, false to keep hard pixel edges.
+ */
+void ImageCache::resample(const sf::Image& source, sf::Vector2u size, sf::Image& result, bool smooth) {
+    sf::Vector2u sourceSize = source.getSize();
+    if (sourceSize.x == 0 || sourceSize.y == 0 || size.x == 0 || size.y == 0) {
+        result.create(size.x, size.y);
+        return;
+    }
+
+    // For every target column and row, list the source pixels it covers and by how much
+    struct Tap {
+        unsigned index;
+        float weight;
+    };
+    auto makeTaps = [smooth](unsigned sourceLength, unsigned targetLength, std::vector<std::vector<Tap>>& taps) {
+        float scale = static_cast<float>(sourceLength) / targetLength;
+        float footprint = smooth ? std::max(scale, 1.f) : scale;
+        taps.resize(targetLength);
+        for (unsigned i = 0; i < targetLength; ++i) {
+            float center = (i + 0.5f) * scale;
+            float begin = center - footprint / 2;
+            float end = center + footprint / 2;
+            for (int j = static_cast<int>(std::floor(begin)); j < end; ++j) {
+                float weight = std::min(j + 1.f, end) - std::max(static_cast<float>(j), begin);
+                if (weight > 0.f) {
+                    int clamped = std::min(std::max(j, 0), static_cast<int>(sourceLength) - 1);
+                    taps[i].push_back({static_cast<unsigned>(clamped), weight});
+                }
+            }
+        }
+    };
+    std::vector<std::vector<Tap>> columns, rows;
+    makeTaps(sourceSize.x, size.x, columns);
+    makeTaps(sourceSize.y, size.y, rows);
+
+    // Weight colors by alpha so transparent pixels do not darken the edges of sprites
+    const sf::Uint8* in = source.getPixelsPtr();
+    std::vector<sf::Uint8> out(static_cast<std::size_t>(size.x) * size.y * 4);
+    for (unsigned y = 0; y < size.y; ++y) {
+        for (unsigned x = 0; x < size.x; ++x) {
+            float r = 0.f, g = 0.f, b = 0.f, a = 0.f, total = 0.f;
+            for (const Tap& row : rows[y]) {
+                const sf::Uint8* line = in + static_cast<std::size_t>(row.index) * sourceSize.x * 4;
+                for (const Tap& column : columns[x]) {
+                    const sf::Uint8* pixel = line + column.index * 4;
+                    float weight = row.weight * column.weight;
+                    float alpha = pixel[3] * weight;
+                    r += pixel[0] * alpha;
+                    g += pixel[1] * alpha;
+                    b += pixel[2] * alpha;
+                    a += alpha;
+                    total += weight;
+                }
+            }
+            sf::Uint8* target = &out[(static_cast<std::size_t>(y) * size.x + x) * 4];
+            if (a > 0.f) {
+                target[0] = static_cast<sf::Uint8>(std::min(r / a + 0.5f, 255.f));
+                target[1] = static_cast<sf::Uint8>(std::min(g / a + 0.5f, 255.f));
+                target[2] = static_cast<sf::Uint8>(std::min(b / a + 0.5f, 255.f));
+                target[3] = static_cast<sf::Uint8>(std::min(a / total + 0.5f, 255.f));
+            } else {
+                target[0] = target[1] = target[2] = target[3] = 0;
+            }
+        }
+    }
+    result.create(size.x, size.y, out.data());
+}
+
+/**
+ * Build the cache key for an asset at a given size.
+ * @param id The asset id of the image.
+ * @param targetSize The requested size, 0x0 for the size of the source.
+ * @param key Set to the cache key.
+ * @return True if the source file was found, false if the image cannot be cached.
+ */
+bool ImageCache::makeKey(const std::string& id, sf::Vector2u targetSize, std::string& key) const {
+    std::string source = AssetPack::getInstance().getSourcePath(id);
+    std::error_code error;
+    auto modified = std::filesystem::last_write_time(source, error);
+    if (error) {
+        return false;
+    }
+    auto size = std::filesystem::file_size(source, error);
+    if (error) {
+        return false;
+    }
+    key = id + "|" + std::to_string(modified.time_since_epoch().count()) + "|" + std::to_string(size) +
+          "|" + std::to_string(targetSize.x) + "x" + std::to_string(targetSize.y);
+    return true;
+}
+
+/**
+ * Check if a stored cache key still matches the source of its image.
+ * @param key The cache key read from an entry.
+ * @return True if the key is what makeKey() builds for the same asset and size now, false otherwise.
+ */
+bool ImageCache::isCurrent(const std::string& key) const {
+    // The key is "id|modification time|file size|WxH", asset ids never contain a '|'
+    std::size_t idEnd = key.find('|');
+    std::size_t sizeStart = key.rfind('|');
+    std::size_t x = key.find('x', sizeStart);
+    if (idEnd == std::string::npos || sizeStart == idEnd || x == std::string::npos) {
+        return false;
+    }
+    sf::Vector2u targetSize;
+    try {
+        targetSize.x = static_cast<unsigned>(std::stoul(key.substr(sizeStart + 1, x - sizeStart - 1)));
+        targetSize.y = static_cast<unsigned>(std::stoul(key.substr(x + 1)));
+    } catch (const std::exception&) {
+        return false;
+    }
+    std::string current;
+    return makeKey(key.substr(0, idEnd), targetSize, current) && current == key;
+}
+
+/**
+ * Delete the entries whose source changed since they were written, and leftover temporary files.
+ */
+void ImageCache::removeStaleEntries() {
+    std::vector<std::filesystem::path> stale;
+    std::error_code error;
+    std::filesystem::directory_iterator it(directory, error), end;
+    for (; !error && it != end; it.increment(error)) {
+        const std::filesystem::path& path = it->path();
+        if (path.extension() == ".tmp") {
+            stale.push_back(path);      // a write that never finished
+        } else if (path.extension() == ".img") {
+            std::ifstream file(path, std::ios::binary);
+            CachedImageHeader header;
+            std::string key;
+            if (!readHeader(file, header, key) || !isCurrent(key)) {
+                stale.push_back(path);
+            }
+        }
+    }
+    for (const auto& path : stale) {
+        std::filesystem::remove(path, error);
+    }
+}
+
+/**
+ * Read the header and the key at the start of a cached image file.
+ * @param file The file, positioned at its start.
+ * @param header The header to fill.
+ * @param key Set to the key stored in the file.
+ * @return True if the file starts with a valid header of this version, false otherwise.
+ */
+bool ImageCache::readHeader(std::istream& file, CachedImageHeader& header, std::string& key) {
+    if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+        std::memcmp(header.magic, magic, sizeof(magic)) != 0 || header.version != version ||
+        header.keyLength > 4096) {
+        return false;
+    }
+    key.assign(header.keyLength, '\0');
+    return header.keyLength == 0 || static_cast<bool>(file.read(&key[0], header.keyLength));
+}
+
+/**
+ * Get the path of the cache file for a key.
+ * @param key The cache key.
+ * @return Path of the cache file.
+ */
+std::string ImageCache::getEntryPath(const std::string& key) const {
+    // FNV-1a, the key stored inside the file settles collisions
+    std::uint64_t hash = 14695981039346656037ull;
+    for (unsigned char c : key) {
+        hash = (hash ^ c) * 1099511628211ull;
+    }
+    char name[17];
+    std::snprintf(name, sizeof(name), "%016llx", static_cast<unsigned long long>(hash));
+    return directory + name + ".img";
+}
+
+/**
+ * Read a cached image.
+ * @param key The cache key of the image.
+ * @param image The image to fill.
+ * @return True if an up to date entry was found, false otherwise.
+ */
+bool ImageCache::read(const std::string& key, sf::Image& image) const {
+    std::ifstream file(getEntryPath(key), std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    CachedImageHeader header;
+    std::string storedKey;
+    if (!readHeader(file, header, storedKey) || storedKey != key) {
+        return false;
+    }
+
+    // Check the sizes of a corrupted entry before allocating for them, the source is decoded instead
+    std::streamoff payloadStart = file.tellg();
+    file.seekg(0, std::ios::end);
+    std::streamoff remaining = file.tellg() - payloadStart;
+    file.seekg(payloadStart);
+    unsigned maximumSize = sf::Texture::getMaximumSize();
+    if (!file || header.payloadSize > static_cast<std::uint64_t>(remaining) ||
+        header.width == 0 || header.height == 0 || header.width > maximumSize || header.height > maximumSize) {
+        return false;
+    }
+
+    std::size_t pixelBytes = static_cast<std::size_t>(header.width) * header.height * 4;
+    std::vector<std::uint8_t> pixels(pixelBytes);
+    if (header.codec == 0) {
+        if (header.payloadSize != pixelBytes ||
+            !file.read(reinterpret_cast<char*>(pixels.data()), static_cast<std::streamsize>(pixelBytes))) {
+            return false;
+        }
+    } else if (header.codec == 1) {
+        std::vector<std::uint8_t> encoded(static_cast<std::size_t>(header.payloadSize));
+        if (!file.read(reinterpret_cast<char*>(encoded.data()), static_cast<std::streamsize>(encoded.size())) ||
+            !decode(encoded, pixels)) {
+            return false;
+        }
+    } else {
+        return false;
+    }
+
+    image.create(header.width, header.height, pixels.data());
+    return true;
+}
+
+/**
+ * Write an image to the cache, replacing an older entry atomically.
+ * @param key The cache key of the image.
+ * @param image The image to store.
+ */
+void ImageCache::write(const std::string& key, const sf::Image& image) {
+    sf::Vector2u size = image.getSize();
+    std::size_t pixelCount = static_cast<std::size_t>(size.x) * size.y;
+    const std::uint8_t* pixels = image.getPixelsPtr();
+
+    // Only keep the encoded pixels when they save a quarter of the space, otherwise raw is faster
+    std::vector<std::uint8_t> encoded;
+    encode(pixels, pixelCount, encoded);
+    bool useEncoded = encoded.size() < pixelCount * 3;
+
+    CachedImageHeader header;
+    std::memcpy(header.magic, magic, sizeof(magic));
+    header.version = version;
+    header.width = size.x;
+    header.height = size.y;
+    header.codec = useEncoded ? 1 : 0;
+    header.keyLength = static_cast<std::uint32_t>(key.size());
+    header.payloadSize = useEncoded ? encoded.size() : pixelCount * 4;
+
+    std::lock_guard<std::mutex> lock(writeMutex);
+    std::string path = getEntryPath(key);
+    std::string temporary = path + ".tmp";
+    {
+        std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            std::cerr << "Failed to write image cache entry " << temporary << std::endl;
+            return;
+        }
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(key.data(), static_cast<std::streamsize>(key.size()));
+        file.write(reinterpret_cast<const char*>(useEncoded ? encoded.data() : pixels),
+                   static_cast<std::streamsize>(header.payloadSize));
+        if (!file) {
+            std::cerr << "Failed to write image cache entry " << temporary << std::endl;
+            return;
+        }
+    }
+    std::error_code error;
+    std::filesystem::rename(temporary, path, error);
+    if (error) {
+        std::filesystem::remove(temporary, error);
+    }
+}
+
+/**
+ * Run-length encode RGBA pixels.
+ * @param pixels The pixels to encode.
+ * @param count The number of pixels.
+ * @param encoded Receives the encoded bytes.
+ */
+void ImageCache::encode(const std::uint8_t* pixels, std::size_t count, std::vector<std::uint8_t>& encoded) {
+    encoded.clear();
+    encoded.reserve(count * 4 + count / 128 + 1);
+    std::size_t i = 0;
+    while (i < count) {
+        // Measure the run of pixels equal to pixel i
+        std::size_t run = 1;
+        while (i + run < count && run < 128 && std::memcmp(pixels + (i + run) * 4, pixels + i * 4, 4) == 0) {
+            ++run;
+        }
+        if (run > 1) {
+            encoded.push_back(static_cast<std::uint8_t>(0x80 | (run - 1)));
+            encoded.insert(encoded.end(), pixels + i * 4, pixels + i * 4 + 4);
+            i += run;
+            continue;
+        }
+
+        // Collect literals until the next run of at least two pixels starts
+        std::size_t literals = 1;
+        while (i + literals < count && literals < 128 &&
+               !(i + literals + 1 < count &&
+                 std::memcmp(pixels + (i + literals) * 4, pixels + (i + literals + 1) * 4, 4) == 0)) {
+            ++literals;
+        }
+        encoded.push_back(static_cast<std::uint8_t>(literals - 1));
+        encoded.insert(encoded.end(), pixels + i * 4, pixels + (i + literals) * 4);
+        i += literals;
+    }
+}
+
+/**
+ * Expand run-length encoded RGBA pixels.
+ * @param encoded The encoded bytes.
+ * @param pixels Receives the pixels, must already have room for every pixel of the image.
+ * @return True if the data was valid and filled the pixels exactly, false otherwise.
+ */
+bool ImageCache::decode(const std::vector<std::uint8_t>& encoded, std::vector<std::uint8_t>& pixels) {
+    std::size_t in = 0;
+    std::size_t out = 0;
+    while (in < encoded.size()) {
+        std::uint8_t control = encoded[in++];
+        std::size_t count = (control & 0x7F) + 1;
+        if (out + count * 4 > pixels.size()) {
+            return false;
+        }
+        if (control & 0x80) {
+            if (in + 4 > encoded.size()) {
+                return false;
+            }
+            for (std::size_t i = 0; i < count; ++i) {
+                std::memcpy(&pixels[out + i * 4], &encoded[in], 4);
+            }
+            in += 4;
+        } else {
+            if (in + count * 4 > encoded.size()) {
+                return false;
+            }
+            std::memcpy(&pixels[out], &encoded[in], count * 4);
+            in += count * 4;
+        }
+        out += count * 4;
+    }
+    return out == pixels.size();
+}
@@ -0,0 +1,174 @@
+/**
+ * @file imagecache.h
+ * @brief Declaration of the ImageCache class and the cached image file format.
+ */
+
+#ifndef FIRE_FIGHTER_IMAGECACHE_H
+#define FIRE_FIGHTER_IMAGECACHE_H
+
+#include <SFML/Graphics.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "assetpack.h"
+#include "loadreport.h"
+
+/**
+ * @brief Header at the start of a cached image file.
+ *
+ * The header is followed by keyLength bytes of the cache key and payloadSize bytes of pixel data,
+ * either raw RGBA or run-length encoded RGBA depending on codec. All integers are stored in native
+ * byte order, the cache is only read on the machine that wrote it.
+ */
+struct CachedImageHeader {
+    char magic[4]; ///< Always "FFIC".
+    std::uint32_t version; ///< Format version, currently 1.
+    std::uint32_t width; ///< Width of the image in pixels.
+    std::uint32_t height; ///< Height of the image in pixels.
+    std::uint32_t codec; ///< 0 for raw pixels, 1 for run-length encoded pixels.
+    std::uint32_t keyLength; ///< Length of the cache key following the header.
+    std::uint64_t payloadSize; ///< Size of the pixel data following the key.
+};
+
+/**
+ * @class ImageCache
+ * @brief Disk cache of decoded images, so JPEG and PNG files are only decoded once.
+ *
+ * Every image is stored as RGBA pixels in the cache directory next to the executable. Entries are
+ * keyed by the asset id, the modification time and size of the file the asset is read from (the
+ * asset pack or the loose file) and the size the image was scaled to, so editing an image or
+ * rebuilding the pack invalidates its entries on the next launch. Those entries are never read
+ * again, so opening the cache deletes every entry whose key no longer matches its source, which
+ * keeps the directory from growing with every pack rebuild. Images with large flat areas are
+ * stored run-length encoded, which is still far cheaper to expand than decoding the source file.
+ *
+ * The cache is safe to use from the Preloader thread and the main thread at the same time.
+ */
+class ImageCache {
+public:
+    static constexpr char magic[4] = {'F', 'F', 'I', 'C'}; ///< Magic bytes at the start of every cached image.
+    static constexpr std::uint32_t version = 1; ///< Format version written and understood.
+
+    /**
+     * @brief Returns the cache shared by the whole process.
+     * @return Reference to the image cache.
+     */
+    static ImageCache& getInstance();
+
+    /**
+     * @brief Loads an image, reading the decoded pixels from the cache when they are up to date.
+     *
+     * On a miss the image is decoded from the AssetPack, scaled if a target size is given and
+     * written to the cache for the next call.
+     *
+     * @param id The asset id of the image (path relative to the project root).
+     * @param image The image to fill.
+     * @param targetSize Size to scale the image to, or 0x0 to keep the size of the source.
+     * @return True if the image was loaded, false otherwise.
+     */
+    bool load(const std::string& id, sf::Image& image, sf::Vector2u targetSize = sf::Vector2u(0, 0));
+
+    /**
+     * @brief Scales an image by averaging the source pixels each target pixel covers.
+     *
+     * Shrinking always averages, so small variants do not shimmer. Enlarging either blends
+     * neighbouring pixels or, for pixel art, only blends along the seams between enlarged pixels.
+     *
+     * @param source The image to scale.
+     * @param size The size of the scaled image.
+     * @param result The image receiving the scaled pixels.
+     * @param smooth True to blend neighbouring pixels when enlarging, false to keep hard pixel edges.
+     */
+    static void resample(const sf::Image& source, sf::Vector2u size, sf::Image& result, bool smooth = true);
+
+private:
+    /**
+     * @brief Private constructor, creates the cache directory if needed and removes stale entries.
+     * @param directory Path of the cache directory relative to the working directory.
+     */
+    explicit ImageCache(const std::string& directory);
+
+    ImageCache(const ImageCache&) = delete;
+    ImageCache& operator=(const ImageCache&) = delete;
+
+    /**
+     * @brief Builds the cache key for an asset at a given size.
+     * @param id The asset id of the image.
+     * @param targetSize The requested size, 0x0 for the size of the source.
+     * @param key Set to the cache key.
+     * @return True if the source file was found, false if the image cannot be cached.
+     */
+    bool makeKey(const std::string& id, sf::Vector2u targetSize, std::string& key) const;
+
+    /**
+     * @brief Gets the path of the cache file for a key.
+     * @param key The cache key.
+     * @return Path of the cache file relative to the working directory.
+     */
+    std::string getEntryPath(const std::string& key) const;
+
+    /**
+     * @brief Checks if a stored cache key still matches the source of its image.
+     * @param key The cache key read from an entry.
+     * @return True if the key is what makeKey() builds for the same asset and size now, false otherwise.
+     */
+    bool isCurrent(const std::string& key) const;
+
+    /**
+     * @brief Deletes the entries whose source changed since they were written, and leftover temporary files.
+     */
+    void removeStaleEntries();
+
+    /**
+     * @brief Reads the header and the key at the start of a cached image file.
+     * @param file The file, positioned at its start.
+     * @param header The header to fill.
+     * @param key Set to the key stored in the file.
+     * @return True if the file starts with a valid header of this version, false otherwise.
+     */
+    static bool readHeader(std::istream& file, CachedImageHeader& header, std::string& key);
+
+    /**
+     * @brief Reads a cached image.
+     * @param key The cache key of the image.
+     * @param image The image to fill.
+     * @return True if an up to date entry was found, false otherwise.
+     */
+    bool read(const std::string& key, sf::Image& image) const;
+
+    /**
+     * @brief Writes an image to the cache, replacing an older entry atomically.
+     * @param key The cache key of the image.
+     * @param image The image to store.
+     */
+    void write(const std::string& key, const sf::Image& image);
+
+    /**
+     * @brief Run-length encodes RGBA pixels.
+     *
+     * Every run starts with a control byte: with the high bit set, the next pixel is repeated
+     * (control & 0x7F) + 1 times, otherwise (control + 1) literal pixels follow.
+     *
+     * @param pixels The pixels to encode.
+     * @param count The number of pixels.
+     * @param encoded Receives the encoded bytes.
+     */
+    static void encode(const std::uint8_t* pixels, std::size_t count, std::vector<std::uint8_t>& encoded);
+
+    /**
+     * @brief Expands run-length encoded RGBA pixels.
+     * @param encoded The encoded bytes.
+     * @param pixels Receives the pixels, must already have room for every pixel of the image.
+     * @return True if the data was valid and filled the pixels exactly, false otherwise.
+     */
+    static bool decode(const std::vector<std::uint8_t>& encoded, std::vector<std::uint8_t>& pixels);
+
+    std::string directory; ///< Path of the cache directory, ending with a slash.
+    bool enabled; ///< False if the cache directory could not be created.
+    std::mutex writeMutex; ///< Serializes writes so two threads never share a temporary file.
+};
+
+#endif //FIRE_FIGHTER_IMAGECACHE_H
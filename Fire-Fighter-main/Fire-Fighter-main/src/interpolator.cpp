@@ -0,0 +1,38 @@
+#include "interpolator.h"
+#include <cmath>
+
+const float Interpolator::snapDistance = 100.f;
+
+/**
+ * Construct an interpolator with no recorded position.
+ */
+Interpolator::Interpolator() : recorded(false) {}
+
+/**
+ * Record the position of a sprite at the start of a simulation tick.
+ * @param sprite The sprite, before the tick moves it.
+ */
+void Interpolator::record(const sf::Sprite& sprite) {
+    previous = sprite.getPosition();
+    recorded = true;
+}
+
+/**
+ * Get a copy of a sprite placed between its recorded and its current position.
+ * @param sprite The sprite at its current position.
+ * @param alpha How far the frame is between the last tick and the next one, from 0 to 1.
+ * @return The sprite to draw.
+ */
+sf::Sprite Interpolator::interpolate(const sf::Sprite& sprite, float alpha) const {
+    sf::Sprite blended(sprite);
+    if (!recorded) {
+        return blended;     // created during the last tick, nothing to blend from
+    }
+    sf::Vector2f current = sprite.getPosition();
+    sf::Vector2f move = current - previous;
+    if (std::abs(move.x) > snapDistance || std::abs(move.y) > snapDistance) {
+        return blended;     // teleported, do not slide across the screen
+    }
+    blended.setPosition(previous + move * alpha);
+    return blended;
+}
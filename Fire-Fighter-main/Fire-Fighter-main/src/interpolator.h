@@ -0,0 +1,51 @@
+/**
+ * @file interpolator.h
+ * @brief Declaration of the Interpolator class.
+ */
+
+#ifndef FIRE_FIGHTER_INTERPOLATOR_H
+#define FIRE_FIGHTER_INTERPOLATOR_H
+
+#include <SFML/Graphics.hpp>
+
+/**
+ * @class Interpolator
+ * @brief Remembers where a sprite was at the previous simulation tick, to draw it in between.
+ *
+ * The game simulates at a fixed tick rate that is lower than the frame rate, so most frames fall
+ * between two ticks. Drawing sprites where the last tick left them would make them move in steps;
+ * instead each moving object records its position at the start of every tick, and frames draw it
+ * blended between that and its current position, by how far the frame clock is into the next tick.
+ *
+ * A jump longer than a normal move, like an enemy wrapping around the screen or an object being
+ * reset, is drawn at the new position right away instead of sliding across the screen.
+ */
+class Interpolator {
+public:
+    /**
+     * @brief Constructs an interpolator with no recorded position, which draws sprites where they are.
+     */
+    Interpolator();
+
+    /**
+     * @brief Records the position of a sprite at the start of a simulation tick.
+     * @param sprite The sprite, before the tick moves it.
+     */
+    void record(const sf::Sprite& sprite);
+
+    /**
+     * @brief Gets a copy of a sprite placed between its recorded and its current position.
+     * @param sprite The sprite at its current position.
+     * @param alpha How far the frame is between the last tick and the next one, from 0 to 1.
+     * @return The sprite to draw.
+     */
+    sf::Sprite interpolate(const sf::Sprite& sprite, float alpha) const;
+
+private:
+    static const float snapDistance; ///< Moves longer than this in one tick are not interpolated.
+
+    sf::Vector2f previous; ///< Position of the sprite at the start of the last tick.
+    bool recorded; ///< Flag indicating whether a position was recorded yet.
+};
+
+#endif //FIRE_FIGHTER_INTERPOLATOR_H
@@ -0,0 +1,107 @@
+#include "loadreport.h"
+#include <algorithm>
+#include <iomanip>
+#include "texturecache.h"
+#include "soundmanager.h"
+#include "preloader.h"
+
+/**
+ * Private constructor of the LoadReport.
+ */
+LoadReport::LoadReport() : totalTime(sf::Time::Zero), totalCount(0) {}
+
+/**
+ * Return the single report shared by the whole process.
+ * @return Reference to the load report.
+ */
+LoadReport& LoadReport::getInstance() {
+    static LoadReport instance;
+    return instance;
+}
+
+/**
+ * Record a load.
+ * @param kind What was loaded.
+ * @param id The asset id, or a description for loads that are not a single asset.
+ * @param time Wall time the load took.
+ * @param bytes Size of the decoded data in memory.
+ * @param size Dimensions in pixels, 0x0 for assets without dimensions.
+ */
+void LoadReport::record(Kind kind, const std::string& id, sf::Time time, std::size_t bytes, sf::Vector2u size) {
+    std::lock_guard<std::mutex> lock(mutex);
+    entries.push_back({kind, id, time, bytes, size});
+    totalTime += time;
+    ++totalCount;
+}
+
+/**
+ * Print the loads recorded since the last report sorted by time, their totals and the resident memory.
+ * @param title Name of the moment the report is printed at.
+ * @param out Stream the report is written to.
+ */
+void LoadReport::print(const std::string& title, std::ostream& out) {
+    std::vector<Entry> batch;
+    sf::Time allTime;
+    std::size_t allCount;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        batch.swap(entries);
+        allTime = totalTime;
+        allCount = totalCount;
+    }
+    std::sort(batch.begin(), batch.end(), [](const Entry& a, const Entry& b) { return a.time > b.time; });
+
+    sf::Time batchTime;
+    std::size_t batchBytes = 0;
+    for (const auto& entry : batch) {
+        batchTime += entry.time;
+        batchBytes += entry.bytes;
+    }
+
+    std::ios::fmtflags flags = out.flags();
+    out << std::fixed << std::setprecision(1);
+    out << "--- Asset loads: " << title << " (" << batch.size() << " loads, " << batchTime.asMicroseconds() / 1000.f
+        << " ms, " << batchBytes / 1024.f << " KB) ---" << std::endl;
+    if (!batch.empty()) {
+        out << std::setw(9) << "ms" << std::setw(11) << "KB" << std::setw(11) << "size" << "  "
+            << std::left << std::setw(13) << "kind" << "asset" << std::right << std::endl;
+    }
+    for (const auto& entry : batch) {
+        std::string size = entry.size.x > 0 ? std::to_string(entry.size.x) + "x" + std::to_string(entry.size.y) : "-";
+        out << std::setw(9) << entry.time.asMicroseconds() / 1000.f << std::setw(11) << entry.bytes / 1024.f
+            << std::setw(11) << size << "  " << std::left << std::setw(13) << getKindName(entry.kind) << entry.id
+            << std::right << std::endl;
+    }
+
+    // Memory still held after the loads, only what the caches keep alive counts
+    out << "Resident: textures " << TextureCache::getInstance().getMemoryUsage() / 1048576.f << " MB, sound effects "
+        << SoundManager::getInstance().getMemoryUsage() / 1048576.f << " MB, preloaded assets "
+        << Preloader::getInstance().getMemoryUsage() / 1048576.f << " MB" << std::endl;
+    out << "Since startup: " << allCount << " loads, " << allTime.asMicroseconds() / 1000.f << " ms" << std::endl;
+    out.flags(flags);
+}
+
+/**
+ * Get the name of a kind of load as printed in the report.
+ * @param kind What was loaded.
+ * @return The name of the kind.
+ */
+const char* LoadReport::getKindName(Kind kind) {
+    switch (kind) {
+        case Image:
+            return "image";
+        case CachedImage:
+            return "cached image";
+        case Texture:
+            return "texture";
+        case Atlas:
+            return "atlas";
+        case Sound:
+            return "sound";
+        case Music:
+            return "music";
+        case Font:
+            return "font";
+    }
+    return "";
+}
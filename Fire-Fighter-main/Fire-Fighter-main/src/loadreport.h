@@ -0,0 +1,100 @@
+/**
+ * @file loadreport.h
+ * @brief Declaration of the LoadReport class.
+ */
+
+#ifndef FIRE_FIGHTER_LOADREPORT_H
+#define FIRE_FIGHTER_LOADREPORT_H
+
+#include <SFML/System.hpp>
+#include <cstddef>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * @class LoadReport
+ * @brief Records how long every asset took to load and how much memory it occupies.
+ *
+ * The loading layer (ImageCache, TextureCache, Preloader, FontService and MusicService) records
+ * every load with its wall time, decoded size and dimensions. print() writes the loads recorded
+ * since the previous report sorted from slowest to fastest, followed by the totals and the memory
+ * currently held by the texture cache, the sound effects and the preloader. A report is printed at
+ * startup and on every scene change, so the slowest assets of each transition stand out.
+ *
+ * Loads are recorded from the preloader and music threads too, so every member is thread safe.
+ */
+class LoadReport {
+public:
+    /**
+     * @brief What was loaded.
+     */
+    enum Kind {
+        Image, ///< Image decoded from its PNG or JPEG source.
+        CachedImage, ///< Image read from the decoded image cache.
+        Texture, ///< Image uploaded to the GPU as a standalone texture.
+        Atlas, ///< Gameplay sprites resized, packed and uploaded as an atlas.
+        Sound, ///< Sound effect decoded into a buffer.
+        Music, ///< Music file read into memory or stream opened.
+        Font ///< Font file parsed.
+    };
+
+    /**
+     * @brief Returns the single report shared by the whole process.
+     * @return Reference to the load report.
+     */
+    static LoadReport& getInstance();
+
+    /**
+     * @brief Records a load.
+     * @param kind What was loaded.
+     * @param id The asset id, or a description for loads that are not a single asset.
+     * @param time Wall time the load took.
+     * @param bytes Size of the decoded data in memory.
+     * @param size Dimensions in pixels, 0x0 for assets without dimensions.
+     */
+    void record(Kind kind, const std::string& id, sf::Time time, std::size_t bytes,
+                sf::Vector2u size = sf::Vector2u(0, 0));
+
+    /**
+     * @brief Prints the loads recorded since the last report, their totals and the resident memory.
+     * @param title Name of the moment the report is printed at, such as the scene being entered.
+     * @param out Stream the report is written to.
+     */
+    void print(const std::string& title, std::ostream& out = std::cout);
+
+private:
+    /**
+     * @brief A recorded load.
+     */
+    struct Entry {
+        Kind kind; ///< What was loaded.
+        std::string id; ///< The asset id or description.
+        sf::Time time; ///< Wall time the load took.
+        std::size_t bytes; ///< Size of the decoded data.
+        sf::Vector2u size; ///< Dimensions in pixels.
+    };
+
+    /**
+     * @brief Private constructor, use getInstance() to access the report.
+     */
+    LoadReport();
+
+    LoadReport(const LoadReport&) = delete;
+    LoadReport& operator=(const LoadReport&) = delete;
+
+    /**
+     * @brief Gets the name of a kind of load as printed in the report.
+     * @param kind What was loaded.
+     * @return The name of the kind.
+     */
+    static const char* getKindName(Kind kind);
+
+    std::vector<Entry> entries; ///< Loads recorded since the last report.
+    sf::Time totalTime; ///< Wall time of every load since startup.
+    std::size_t totalCount; ///< Number of loads since startup.
+    std::mutex mutex; ///< Guards every member above.
+};
+
+#endif //FIRE_FIGHTER_LOADREPORT_H
@@ -1,6 +1,19 @@
 #include "ui.h"
+#include "game.h"
+#include "headlessoptions.h"
+
+int main(int argc, char* argv[]) {
+    HeadlessOptions headless;
+    if (!headless.parse(argc, argv)) {
+        return 1;
+    }
+    if (headless.enabled) {
+        Settings options;       // benchmark the configured game without a window or sound
+        options.disableAudio();
+        Game benchmark(&options, headless);
+        return benchmark.runHeadless() ? 0 : 1;
+    }
 
-int main() {
     Ui program;             // create a new UI menu
     program.displayMenu();  // run UI window loop
     return 0;
@@ -0,0 +1,52 @@
+#include "menueventqueue.h"
+#include <algorithm>
+
+/**
+ * Construct a queue reading the events of a window.
+ * @param window The window of the menu.
+ */
+MenuEventQueue::MenuEventQueue(sf::Window& window) : window(window), hasWaited(false) {}
+
+/**
+ * Take the next pending event without blocking.
+ * @param event Filled with the event if there is one.
+ * @return True if an event was returned, false if there are no pending events.
+ */
+bool MenuEventQueue::poll(sf::Event& event) {
+    if (hasWaited) {
+        event = waited;
+        hasWaited = false;
+        return true;
+    }
+    return window.pollEvent(event);
+}
+
+/**
+ * Sleep until an event is pending or the timeout expires.
+ * @param timeout Longest time to sleep, sf::Time::Zero to sleep until the next event.
+ * @return True if an event is pending, false on timeout or if the window was closed.
+ */
+bool MenuEventQueue::wait(sf::Time timeout) {
+    if (hasWaited) {
+        return true;
+    }
+    if (timeout == sf::Time::Zero) {
+        hasWaited = window.waitEvent(waited);   // blocks in the OS until there is input
+        return hasWaited;
+    }
+
+    // SFML cannot wait with a timeout, so check for events between short sleeps
+    sf::Clock clock;
+    while (window.isOpen()) {
+        if (window.pollEvent(waited)) {
+            hasWaited = true;
+            return true;
+        }
+        sf::Time remaining = timeout - clock.getElapsedTime();
+        if (remaining <= sf::Time::Zero) {
+            return false;
+        }
+        sf::sleep(std::min(remaining, sf::milliseconds(10)));
+    }
+    return false;
+}
@@ -0,0 +1,52 @@
+/**
+ * @file menueventqueue.h
+ * @brief Declaration of the MenuEventQueue class.
+ */
+
+#ifndef FIRE_FIGHTER_MENUEVENTQUEUE_H
+#define FIRE_FIGHTER_MENUEVENTQUEUE_H
+
+#include <SFML/Window.hpp>
+#include <SFML/System.hpp>
+
+/**
+ * @class MenuEventQueue
+ * @brief Event source for menu loops that only redraw when something happens.
+ *
+ * A menu screen does not change unless the user does something, so instead of redrawing at the
+ * frame rate a menu loop drains its events with poll(), draws once and then sleeps in wait() until
+ * the next event arrives. Menus with an animation pass a timeout to wait(), so they wake up for the
+ * next animation frame even without input.
+ *
+ * wait() has to take an event off the window to know that one arrived; that event is handed out by
+ * the next poll(), so loops see every event exactly once and in order.
+ */
+class MenuEventQueue {
+public:
+    /**
+     * @brief Constructs a queue reading the events of a window.
+     * @param window The window of the menu.
+     */
+    explicit MenuEventQueue(sf::Window& window);
+
+    /**
+     * @brief Takes the next pending event without blocking, like sf::Window::pollEvent().
+     * @param event Filled with the event if there is one.
+     * @return True if an event was returned, false if there are no pending events.
+     */
+    bool poll(sf::Event& event);
+
+    /**
+     * @brief Sleeps until an event is pending or the timeout expires.
+     * @param timeout Longest time to sleep, sf::Time::Zero to sleep until the next event.
+     * @return True if an event is pending, false on timeout or if the window was closed.
+     */
+    bool wait(sf::Time timeout = sf::Time::Zero);
+
+private:
+    sf::Window& window; ///< The window of the menu.
+    sf::Event waited; ///< Event taken off the window by wait(), returned by the next poll().
+    bool hasWaited; ///< Flag indicating whether waited holds an event.
+};
+
+#endif //FIRE_FIGHTER_MENUEVENTQUEUE_H
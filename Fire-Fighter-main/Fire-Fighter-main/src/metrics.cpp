@@ -3,17 +3,16 @@
 /**
  * @brief Constructor of Metrics.
  *
- * Initializes a Metrics object with the given window size and optional settings.
- * It calculates the height of the infoBar as 10% of the window's height and creates an infoBar accordingly.
+ * Initializes a Metrics object in the virtual space with the given settings.
+ * It calculates the height of the infoBar as 10% of the virtual height and creates an infoBar accordingly.
  * Various text elements such as score, enemy killed count, round number, and enemies remaining are initialized and positioned on the infoBar.
  * Life counter textures are loaded for displaying health status, and the health bar sprite is set up accordingly.
  *
- * @param windowSize The size of the game window.
  * @param opt Optional settings for customizing the Metrics object.
  * @authors Prachi Ghevaria, Robert Andrew Biernacki
  */
-Metrics::Metrics(sf::Vector2u windowSize, Settings* opt) : score(0), windowSize(windowSize) {
-    // Calculate the infoBar height as 10% of the window's height
+Metrics::Metrics(Settings* opt) : score(0), savesHighestScore(true), windowSize(VirtualView::getSize()), density(1.f), lives(3), hudLayered(false), hudDirty(true) {
+    // Calculate the infoBar height as 10% of the virtual height
     float infoBarHeight = windowSize.y * 0.1f;
 
     // Load the highest score from file
@@ -36,54 +35,99 @@ Metrics::Metrics(sf::Vector2u windowSize, Settings* opt) : score(0), windowSize(
     separationLine.setPosition(0, infoBarHeight - 3);
 
     options = opt; // Assign optional settings
-    font = opt->getFont(); // Get font from settings
+    font = &opt->getFont(); // Get the shared font from settings
 
-    // Initialize and position the score text
-    scoreText.setFont(font);
-    scoreText.setCharacterSize(opt->heightScaling(20));
+    // Initialize the score text
+    scoreText.setFont(*font);
     scoreText.setFillColor(sf::Color::White);
     scoreText.setString(opt->getLanguage()[22] + std::to_string(score));
-    scoreText.setPosition(((windowSize.x * 0.7f) - (scoreText.getLocalBounds().width) / 2.f), (infoBarHeight/2) - (scoreText.getLocalBounds().height/2));
 
-    // Initialize and position the enemy killed text
-    enemyKilledText.setFont(font);
-    enemyKilledText.setCharacterSize(opt->heightScaling(20));
+    // Initialize the enemy killed text
+    enemyKilledText.setFont(*font);
     enemyKilledText.setFillColor(sf::Color::White);
     enemyKilledText.setString(opt->getLanguage()[23]+ std::to_string(score));
-    enemyKilledText.setPosition((((windowSize.x) * 0.48f) - (enemyKilledText.getLocalBounds().width) / 2.f), (infoBarHeight/2) - (enemyKilledText.getLocalBounds().height/2));
 
-    // Initialize and position the round text
-    roundText.setFont(font);
-    roundText.setCharacterSize(opt->heightScaling(20));
+    // Initialize the round text
+    roundText.setFont(*font);
     roundText.setFillColor(sf::Color::White);
     roundText.setString(opt->getLanguage()[24] + std::to_string(score));
-    roundText.setPosition((((windowSize.x) * 0.6f) - (roundText.getLocalBounds().width) / 2.f), (infoBarHeight/2) - (roundText.getLocalBounds().height/2));
 
-    // Initialize and position the enemies remaining text
-    enemiesRemainingText.setFont(font);
-    enemiesRemainingText.setCharacterSize(opt->heightScaling(20));
+    // Initialize the enemies remaining text
+    enemiesRemainingText.setFont(*font);
     enemiesRemainingText.setFillColor(sf::Color::White);
     enemiesRemainingText.setString(opt->getLanguage()[25] + std::to_string(score));
-    enemiesRemainingText.setPosition((((windowSize.x) * 0.3f) - (enemiesRemainingText.getLocalBounds().width) / 2.f), (infoBarHeight/2) - (enemiesRemainingText.getLocalBounds().height/2));
 
-    // Initialize and position the highest score text
-    highestScoreText.setFont(font);
-    highestScoreText.setCharacterSize(opt->heightScaling(20));
+    // Initialize the highest score text
+    highestScoreText.setFont(*font);
     highestScoreText.setFillColor(sf::Color::White);
     highestScoreText.setString(opt->getLanguage()[26] + std::to_string(highestScore));
-    highestScoreText.setPosition((((windowSize.x) * 0.82f) - (highestScoreText.getLocalBounds().width) / 2.f), (infoBarHeight/2) - (highestScoreText.getLocalBounds().height/2));
-
-    // Load life counter textures and set up health bar sprite
-    if (!life3Texture.loadFromFile("../../resource/img/3.png") ||
-        !life2Texture.loadFromFile("../../resource/img/2.png") ||
-        !life1Texture.loadFromFile("../../resource/img/1.png") ||
-        !life0Texture.loadFromFile("../../resource/img/0.png")) {
-        std::cerr << "Failed to load life counter textures!" << std::endl;
-        return;
+
+    // Acquire the life counter textures, size and position the texts and create the HUD layer,
+    // at 1:1 until the window sets its density
+    setPixelDensity(density);
+}
+
+/**
+ * @brief Set the number of window pixels per virtual unit the HUD is shown at.
+ *
+ * The texts are rasterized at their size on screen, the life counter textures are acquired from the
+ * atlas for the same density, and the HUD is rendered into its own layer at that density and only
+ * redrawn when a value changes.
+ *
+ * @param density The number of window pixels per virtual unit.
+ */
+void Metrics::setPixelDensity(float density) {
+    this->density = density;
+    TextureCache& cache = TextureCache::getInstance();
+    life3Texture = cache.acquireRegion("resource/img/3.png", VirtualView::getResolution());
+    life2Texture = cache.acquireRegion("resource/img/2.png", VirtualView::getResolution());
+    life1Texture = cache.acquireRegion("resource/img/1.png", VirtualView::getResolution());
+    life0Texture = cache.acquireRegion("resource/img/0.png", VirtualView::getResolution());
+    showLives();
+    VirtualView::setCharacterSize(scoreText, 20.f, density);
+    VirtualView::setCharacterSize(enemyKilledText, 20.f, density);
+    VirtualView::setCharacterSize(roundText, 20.f, density);
+    VirtualView::setCharacterSize(enemiesRemainingText, 20.f, density);
+    VirtualView::setCharacterSize(highestScoreText, 20.f, density);
+    placeTexts();
+    hudDirty = true;
+
+    float infoBarHeight = windowSize.y * 0.1f;
+    hudLayered = hudLayer.create(static_cast<unsigned>(windowSize.x * density + 0.5f), static_cast<unsigned>(infoBarHeight * density + 0.5f));
+    if (hudLayered) {
+        hudLayer.setView(sf::View(sf::FloatRect(0.f, 0.f, windowSize.x, infoBarHeight)));
+        hudSprite.setTexture(hudLayer.getTexture(), true);
+        hudSprite.setScale(1.f / density, 1.f / density);
+    } else {
+        std::cerr << "Failed to create the HUD layer, drawing the HUD directly" << std::endl;
     }
-    healthBar.setTexture(life3Texture);
-    healthBar.setScale(opt->widthScaling(1.4), opt->widthScaling(1.4));
-    healthBar.setPosition(windowSize.x * 0.03, (infoBarHeight/2) - (life3Texture.getSize().y / 2));
+}
+
+/**
+ * @brief Position the texts on the infoBar.
+ */
+void Metrics::placeTexts() {
+    float infoBarHeight = windowSize.y * 0.1f;
+    scoreText.setPosition(((windowSize.x * 0.7f) - (scoreText.getGlobalBounds().width) / 2.f), (infoBarHeight/2) - (scoreText.getGlobalBounds().height/2));
+    enemyKilledText.setPosition((((windowSize.x) * 0.48f) - (enemyKilledText.getGlobalBounds().width) / 2.f), (infoBarHeight/2) - (enemyKilledText.getGlobalBounds().height/2));
+    roundText.setPosition((((windowSize.x) * 0.6f) - (roundText.getGlobalBounds().width) / 2.f), (infoBarHeight/2) - (roundText.getGlobalBounds().height/2));
+    enemiesRemainingText.setPosition((((windowSize.x) * 0.3f) - (enemiesRemainingText.getGlobalBounds().width) / 2.f), (infoBarHeight/2) - (enemiesRemainingText.getGlobalBounds().height/2));
+    highestScoreText.setPosition((((windowSize.x) * 0.82f) - (highestScoreText.getGlobalBounds().width) / 2.f), (infoBarHeight/2) - (highestScoreText.getGlobalBounds().height/2));
+}
+
+/**
+ * @brief Build the glyph geometry of the texts after they changed.
+ *
+ * sf::Text builds its geometry lazily on the first measure or draw. Doing it here on the game thread
+ * means the copies in a RenderSnapshot carry finished geometry, instead of every copy being laid out
+ * again on the render thread each frame.
+ */
+void Metrics::layOutTexts() {
+    scoreText.getLocalBounds();
+    roundText.getLocalBounds();
+    enemyKilledText.getLocalBounds();
+    enemiesRemainingText.getLocalBounds();
+    highestScoreText.getLocalBounds();
 }
 
 /**
@@ -105,34 +149,70 @@ Metrics::~Metrics() = default;
  * @author Prachi Ghevaria
  */
 void Metrics::updateHealthbar(int lives){
+    if (lives == this->lives) {
+        return;     // called every frame, only a change needs the HUD redrawn
+    }
+    this->lives = lives;
+    hudDirty = true;
+    showLives();
+}
+
+/**
+ * @brief Set the life counter texture for the current number of lives to the health bar.
+ */
+void Metrics::showLives() {
     switch (lives) {
         case 3:
-            healthBar.setTexture(life3Texture);
+            life3Texture.apply(healthBar);
             break;
         case 2:
-            healthBar.setTexture(life2Texture);
+            life2Texture.apply(healthBar);
             break;
         case 1:
-            healthBar.setTexture(life1Texture);
+            life1Texture.apply(healthBar);
             break;
         case 0:
-            healthBar.setTexture(life0Texture);
+            life0Texture.apply(healthBar);
             break;
         default:
             break;
     }
+    float infoBarHeight = windowSize.y * 0.1f;
+    healthBar.setPosition(windowSize.x * 0.03f, (infoBarHeight / 2) - (healthBar.getGlobalBounds().height / 2));
 }
 
 /**
  * @brief Draw the metrics elements on the specified render target.
  *
- * This function draws various metrics elements, such as the infoBar, separation line, score text, round text, health bar,
- * enemy killed text, and enemies remaining text, on the specified render target (window).
+ * This function composites the HUD layer onto the specified render target (window) with a single draw,
+ * redrawing the layer first if a metric changed since the last frame.
  *
  * @param window The render target (SFML RenderTarget) to draw the metrics elements on.
  * @author Prachi Ghevaria
  */
 void Metrics::draw(sf::RenderTarget& window) {
+    if (!hudLayered) {
+        drawElements(window);
+        return;
+    }
+    if (hudDirty) {
+        hudLayer.clear(sf::Color::Transparent);
+        drawElements(hudLayer);
+        hudLayer.display();
+        hudDirty = false;
+    }
+    window.draw(hudSprite);
+}
+
+/**
+ * @brief Draw every element of the HUD.
+ *
+ * This function draws the infoBar, separation line, score text, round text, health bar,
+ * enemy killed text, and enemies remaining text on the specified render target.
+ *
+ * @param window The render target to draw the metrics elements on, the HUD layer or the window.
+ */
+void Metrics::drawElements(sf::RenderTarget& window) {
     window.draw(infoBar);
     window.draw(separationLine);
     window.draw(scoreText);
@@ -143,6 +223,22 @@ void Metrics::draw(sf::RenderTarget& window) {
     window.draw(highestScoreText);
 }
 
+/**
+ * @brief Copy every element of the HUD into a render snapshot.
+ *
+ * @param snapshot The snapshot of the frame, drawn with the same view as the HUD.
+ */
+void Metrics::capture(RenderSnapshot& snapshot) const {
+    snapshot.shapes.push_back(infoBar);
+    snapshot.shapes.push_back(separationLine);
+    snapshot.sprites.push_back(healthBar);
+    snapshot.texts.push_back(scoreText);
+    snapshot.texts.push_back(roundText);
+    snapshot.texts.push_back(enemyKilledText);
+    snapshot.texts.push_back(enemiesRemainingText);
+    snapshot.texts.push_back(highestScoreText);
+}
+
 /**
  * @brief Draw the final score elements on the specified render target.
  *
@@ -154,10 +250,11 @@ void Metrics::draw(sf::RenderTarget& window) {
  */
 void Metrics::drawFinalScore(sf::RenderTarget& window) {
     // Position the score text, roundtext, enemy killed text, and highest score text
-    scoreText.setPosition(((windowSize.x * 0.5f) - (scoreText.getLocalBounds().width) / 2.f), (options->getResolution()[1]/3) - (scoreText.getLocalBounds().height * 8.5));
-    roundText.setPosition(((windowSize.x * 0.5f) - (roundText.getLocalBounds().width) / 2.f), (options->getResolution()[1]/3) - (roundText.getLocalBounds().height * 5));
-    enemyKilledText.setPosition(((windowSize.x * 0.5f) - (enemyKilledText.getLocalBounds().width) / 2.f), (options->getResolution()[1]/3) - (enemyKilledText.getLocalBounds().height * 1));
-    highestScoreText.setPosition(((windowSize.x * 0.5f) - (highestScoreText.getLocalBounds().width) / 2.f), (options->getResolution()[1]/3) - (highestScoreText.getLocalBounds().height * 3));
+    scoreText.setPosition(((windowSize.x * 0.5f) - (scoreText.getGlobalBounds().width) / 2.f), (windowSize.y/3) - (scoreText.getGlobalBounds().height * 8.5));
+    roundText.setPosition(((windowSize.x * 0.5f) - (roundText.getGlobalBounds().width) / 2.f), (windowSize.y/3) - (roundText.getGlobalBounds().height * 5));
+    enemyKilledText.setPosition(((windowSize.x * 0.5f) - (enemyKilledText.getGlobalBounds().width) / 2.f), (windowSize.y/3) - (enemyKilledText.getGlobalBounds().height * 1));
+    highestScoreText.setPosition(((windowSize.x * 0.5f) - (highestScoreText.getGlobalBounds().width) / 2.f), (windowSize.y/3) - (highestScoreText.getGlobalBounds().height * 3));
+    hudDirty = true;    // the texts left the info bar
 
     window.draw(scoreText);
     window.draw(roundText);
@@ -176,6 +273,8 @@ void Metrics::drawFinalScore(sf::RenderTarget& window) {
 void Metrics::setEnemyCount(int enemyCount) {
     enemySum = enemyCount;
     enemiesRemainingText.setString(options->getLanguage()[25] + std::to_string(enemyCount));
+    enemiesRemainingText.getLocalBounds();  // lay out the glyphs here, not on the render thread
+    hudDirty = true;
 }
 
 /**
@@ -194,6 +293,8 @@ void Metrics::increaseScore(int points) {
     enemyKilledText.setString(options->getLanguage()[23] + std::to_string(score/points));
     enemiesRemainingText.setString(options->getLanguage()[25] + std::to_string((enemySum - (score/points) % enemySum)));
     highestScoreText.setString(options->getLanguage()[26] + std::to_string(highestScore));
+    layOutTexts();
+    hudDirty = true;
 }
 
 /**
@@ -207,6 +308,9 @@ void Metrics::updateHighestScore() {
     // Update highest score if current score is greater
     if (score > highestScore) {
         highestScore = score;
+        if (!savesHighestScore) {
+            return;
+        }
 
         // Store the highest score in a file
         std::ofstream outFile("../../config/highestScore.txt");
@@ -218,6 +322,14 @@ void Metrics::updateHighestScore() {
         }
     }
 }
+/**
+ * @brief Set whether a new highest score is stored in highestScore.txt.
+ * @param save True to store new highest scores, false to keep them in memory only.
+ */
+void Metrics::setSavesHighestScore(bool save) {
+    savesHighestScore = save;
+}
+
 /**
  * @brief Return the highest score.
  * @return int The current highest score.
@@ -236,23 +348,16 @@ int Metrics::getHighestScore() const {
  */
 void Metrics::reset() {
     score = 0;
-    float infoBarHeight = windowSize.y * 0.1f;
-    healthBar.setTexture(life3Texture);
+    lives = 3;
+    showLives();
+    hudDirty = true;
 
     scoreText.setString(options->getLanguage()[22] + std::to_string(score));
-    scoreText.setPosition(((windowSize.x * 0.7f) - (scoreText.getLocalBounds().width) / 2.f), (infoBarHeight/2) - (scoreText.getLocalBounds().height/2));
-
     enemyKilledText.setString(options->getLanguage()[23]+ std::to_string(score));
-    enemyKilledText.setPosition((((windowSize.x) * 0.48f) - (enemyKilledText.getLocalBounds().width) / 2.f), (infoBarHeight/2) - (enemyKilledText.getLocalBounds().height/2));
-
     roundText.setString(options->getLanguage()[24] + std::to_string(score));
-    roundText.setPosition((((windowSize.x) * 0.6f) - (roundText.getLocalBounds().width) / 2.f), (infoBarHeight/2) - (roundText.getLocalBounds().height/2));
-
     enemiesRemainingText.setString(options->getLanguage()[25] + std::to_string(score));
-    enemiesRemainingText.setPosition((((windowSize.x) * 0.3f) - (enemiesRemainingText.getLocalBounds().width) / 2.f), (infoBarHeight/2) - (enemiesRemainingText.getLocalBounds().height/2));
-
     highestScoreText.setString(options->getLanguage()[26] + std::to_string(highestScore));
-    highestScoreText.setPosition((((windowSize.x) * 0.82f) - (highestScoreText.getLocalBounds().width) / 2.f), (infoBarHeight/2) - (highestScoreText.getLocalBounds().height/2));
+    placeTexts();   // measures the texts, which lays them out as well
 
 }
 
@@ -5,6 +5,9 @@
 #include <iostream>
 #include <string>
 #include "settings.h"
+#include "texturecache.h"
+#include "virtualview.h"
+#include "renderthread.h"
 
 /**
  * @author Prachi Ghevaria
@@ -12,21 +15,37 @@
  *
  * This class handles various game metrics such as score, health, and stage information.
  * It also manages the display of these metrics on the game screen.
+ *
+ * The HUD is rendered into an off-screen layer that is only redrawn after one of the metrics changed,
+ * so a frame normally costs a single draw of the layer instead of drawing every shape and text.
+ *
+ * The HUD is laid out in the virtual space of the game and drawn with the same view as the gameplay.
+ * Its layer and its texts are rasterized at the pixel density of the window, see setPixelDensity(),
+ * so they stay sharp when the view magnifies them.
  */
 class Metrics {
 public:
     /**
      * @brief Constructs a Metrics object with specified parameters.
      *
-     * Initializes a Metrics object with the given window size and optional settings.
-     * It calculates the height of the infoBar as 10% of the window's height and creates an infoBar accordingly.
+     * Initializes a Metrics object in the virtual space with the given settings.
+     * It calculates the height of the infoBar as 10% of the virtual height and creates an infoBar accordingly.
      * Various text elements such as score, enemy killed count, round number, and enemies remaining are initialized and positioned on the infoBar.
      * Life counter textures are loaded for displaying health status, and the health bar sprite is set up accordingly.
      *
-     * @param windowSize The size of the game window.
      * @param opt Optional settings for customizing the Metrics object.
      */
-    Metrics(sf::Vector2u windowSize, Settings* opt);
+    explicit Metrics(Settings* opt);
+
+    /**
+     * @brief Sets the number of window pixels per virtual unit the HUD is shown at.
+     *
+     * Rasterizes the texts and recreates the HUD layer for the new density, so the HUD stays sharp
+     * after the window changed size.
+     *
+     * @param density The number of window pixels per virtual unit.
+     */
+    void setPixelDensity(float density);
 
     /**
      * @brief Default destructor for the Metrics class.
@@ -49,8 +68,9 @@ public:
     /**
      * @brief Draws the metrics elements on the specified render target.
      *
-     * This function draws various metrics elements, such as the infoBar, separation line, score text, round text, health bar,
-     * enemy killed text, and enemies remaining text, on the specified render target (window).
+     * This function draws the HUD layer holding the infoBar, separation line, score text, round text, health bar,
+     * enemy killed text, and enemies remaining text, on the specified render target (window). The layer is
+     * redrawn first if a metric changed since the last call.
      *
      * @param window The render target (SFML RenderTarget) to draw the metrics elements on.
      */
@@ -67,6 +87,16 @@ public:
      */
     void drawFinalScore(sf::RenderTarget& target);
 
+    /**
+     * @brief Copies the metrics elements into a render snapshot.
+     *
+     * The render thread draws the copies directly, without the HUD layer, so the game thread can keep
+     * updating the metrics while the frame is drawn.
+     *
+     * @param snapshot The snapshot of the frame.
+     */
+    void capture(RenderSnapshot& snapshot) const;
+
     /**
      * @brief Sets the count of remaining enemies and updates the corresponding text.
      *
@@ -96,6 +126,16 @@ public:
      */
     void updateHighestScore();
 
+    /**
+     * @brief Sets whether a new highest score is stored in highestScore.txt.
+     *
+     * The highest score is still tracked and shown when saving is turned off, which keeps scripted
+     * runs such as the headless benchmark from overwriting the score of the player.
+     *
+     * @param save True to store new highest scores, false to keep them in memory only.
+     */
+    void setSavesHighestScore(bool save);
+
     /**
      * @brief Returns the highest score achieved.
      *
@@ -126,11 +166,34 @@ public:
     int getStage();
 
 private:
+    /**
+     * @brief Draws every element of the HUD on the specified render target.
+     *
+     * @param window The render target, the HUD layer or the window if the layer could not be created.
+     */
+    void drawElements(sf::RenderTarget& window);
+
+    /**
+     * @brief Positions the texts on the infoBar.
+     */
+    void placeTexts();
+
+    /**
+     * @brief Builds the glyph geometry of the texts, so the copies taken by capture() carry it.
+     */
+    void layOutTexts();
+
+    /**
+     * @brief Sets the life counter texture for the current number of lives to the health bar.
+     */
+    void showLives();
+
     int highestScore; /** The player's highest score. **/
     sf::RectangleShape infoBar; /**< The rectangular shape representing the info bar. */
     sf::RectangleShape separationLine; /**< The rectangular shape representing the separation line within the info bar. */
-    sf::Font font; /**< The font used for text rendering. */
-    sf::Vector2u windowSize; /**< The size of the game window. */
+    const sf::Font* font; /**< The shared font used for text rendering. */
+    sf::Vector2u windowSize; /**< The size of the virtual space the HUD is laid out in. */
+    float density; /**< The number of window pixels per virtual unit. */
     sf::Text scoreText; /**< The text displaying the player's score. */
     sf::Text roundText; /**< The text displaying the current round. */
     sf::Text enemyKilledText; /**< The text displaying the number of enemies killed. */
@@ -138,12 +201,18 @@ private:
     sf::Text highestScoreText; /**<The text displaying the highest score. */
     Settings* options; /**< Pointer to the settings object. */
     int score; /**< The player's current score. */
+    bool savesHighestScore; /**< Flag indicating whether a new highest score is stored in highestScore.txt. */
     int enemySum; /**< The total number of enemies. */
-    sf::Texture life3Texture; /**< The texture representing 3 lives for the health bar. */
-    sf::Texture life2Texture; /**< The texture representing 2 lives for the health bar. */
-    sf::Texture life1Texture; /**< The texture representing 1 life for the health bar. */
-    sf::Texture life0Texture; /**< The texture representing 0 lives for the health bar. */
+    TextureRegion life3Texture; /**< The texture representing 3 lives for the health bar. */
+    TextureRegion life2Texture; /**< The texture representing 2 lives for the health bar. */
+    TextureRegion life1Texture; /**< The texture representing 1 life for the health bar. */
+    TextureRegion life0Texture; /**< The texture representing 0 lives for the health bar. */
     sf::Sprite healthBar; /**< The sprite representing the health bar. */
+    int lives; /**< The number of lives shown by the health bar. */
+    sf::RenderTexture hudLayer; /**< Off-screen layer holding the rendered HUD. */
+    sf::Sprite hudSprite; /**< Sprite drawing the HUD layer onto the window. */
+    bool hudLayered; /**< Flag indicating whether the HUD layer could be created. */
+    bool hudDirty; /**< Flag indicating whether a metric changed since the HUD layer was drawn. */
 
 };
 
@@ -0,0 +1,184 @@
+#include "musicservice.h"
+
+/**
+ * Private constructor of the MusicService, starts the worker thread.
+ */
+MusicService::MusicService() : quit(false) {
+    worker = std::thread(&MusicService::run, this);
+}
+
+/**
+ * Destructor of the MusicService, stops the worker thread.
+ */
+MusicService::~MusicService() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        quit = true;
+    }
+    wake.notify_all();
+    if (worker.joinable()) {
+        worker.join();
+    }
+}
+
+/**
+ * Return the single music service shared by the whole process.
+ * @return Reference to the music service.
+ */
+MusicService& MusicService::getInstance() {
+    static MusicService instance;
+    return instance;
+}
+
+/**
+ * Open a track on the worker thread so a later play() starts without delay.
+ * @param id The asset id of the music.
+ */
+void MusicService::prefetch(const std::string& id) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (tracks.count(id)) {
+            return;
+        }
+        pending.push_back(id);
+    }
+    wake.notify_all();
+}
+
+/**
+ * Crossfade from the current track to the given track.
+ * @param id The asset id of the music.
+ * @param fadeTime Duration of the crossfade.
+ */
+void MusicService::play(const std::string& id, sf::Time fadeTime) {
+    sf::Music* next = acquire(id);
+    if (next == nullptr) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if (current == id && next->getStatus() == sf::SoundSource::Playing) {
+        fade(next, 100.f, fadeTime, sf::SoundSource::Playing);     // cancel a fade out in progress
+        return;
+    }
+    if (!current.empty() && current != id) {
+        fade(tracks[current].get(), 0.f, fadeTime, sf::SoundSource::Paused);
+    }
+    current = id;
+    if (next->getStatus() != sf::SoundSource::Playing) {
+        next->setVolume(fadeTime > sf::Time::Zero ? 0.f : 100.f);
+        next->play();
+    }
+    fade(next, 100.f, fadeTime, sf::SoundSource::Playing);
+    wake.notify_all();
+}
+
+/**
+ * Fade out and stop the current track, rewinding it to the beginning.
+ * @param fadeTime Duration of the fade out.
+ */
+void MusicService::stop(sf::Time fadeTime) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (current.empty()) {
+        return;
+    }
+    fade(tracks[current].get(), 0.f, fadeTime, sf::SoundSource::Stopped);
+    current.clear();
+    wake.notify_all();
+}
+
+/**
+ * Get an open track, opening it if needed.
+ * @param id The asset id of the music.
+ * @return The track, or nullptr if it could not be opened.
+ */
+sf::Music* MusicService::acquire(const std::string& id) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = tracks.find(id);
+        if (it != tracks.end()) {
+            return it->second.get();
+        }
+    }
+
+    // Open outside the lock, so fades keep running while the stream header is parsed
+    sf::Clock clock;
+    auto music = std::make_unique<sf::Music>();
+    if (!Preloader::getInstance().openMusic(id, *music)) {
+        std::cerr << "Failed to load music " << id << std::endl;
+        return nullptr;
+    }
+    music->setLoop(true);
+    LoadReport::getInstance().record(LoadReport::Music, id, clock.getElapsedTime(), 0);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    auto& track = tracks[id];
+    if (!track) {       // another thread may have opened it meanwhile
+        track = std::move(music);
+    }
+    return track.get();
+}
+
+/**
+ * Replace the fade of a track.
+ * @param music The track to fade.
+ * @param to The target volume.
+ * @param duration Duration of the fade.
+ * @param endStatus Status applied to the track when the fade is over.
+ */
+void MusicService::fade(sf::Music* music, float to, sf::Time duration, sf::SoundSource::Status endStatus) {
+    for (auto it = fades.begin(); it != fades.end(); ++it) {
+        if (it->music == music) {
+            fades.erase(it);
+            break;
+        }
+    }
+    Fade ramp;
+    ramp.music = music;
+    ramp.from = music->getVolume();
+    ramp.to = to;
+    ramp.duration = duration;
+    ramp.endStatus = endStatus;
+    fades.push_back(ramp);
+}
+
+/**
+ * Body of the worker thread, opens prefetched tracks and advances the fades.
+ */
+void MusicService::run() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (!quit) {
+        if (!pending.empty()) {
+            std::string id = pending.back();
+            pending.pop_back();
+            lock.unlock();
+            acquire(id);
+            lock.lock();
+            continue;
+        }
+
+        // Advance every fade, finished ones leave the track at its final volume and status
+        for (auto it = fades.begin(); it != fades.end();) {
+            float progress = it->duration > sf::Time::Zero ? it->clock.getElapsedTime() / it->duration : 1.f;
+            if (progress >= 1.f) {
+                it->music->setVolume(it->to);
+                if (it->endStatus == sf::SoundSource::Paused) {
+                    it->music->pause();
+                } else if (it->endStatus == sf::SoundSource::Stopped) {
+                    it->music->stop();
+                    it->music->setVolume(100.f);
+                }
+                it = fades.erase(it);
+            } else {
+                it->music->setVolume(it->from + (it->to - it->from) * progress);
+                ++it;
+            }
+        }
+
+        if (fades.empty()) {
+            wake.wait(lock, [this] { return quit || !pending.empty() || !fades.empty(); });
+        } else {
+            wake.wait_for(lock, std::chrono::milliseconds(15));
+        }
+    }
+}
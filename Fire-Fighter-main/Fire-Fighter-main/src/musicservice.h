@@ -0,0 +1,118 @@
+/**
+ * @file musicservice.h
+ * @brief Declaration of the MusicService class.
+ */
+
+#ifndef FIRE_FIGHTER_MUSICSERVICE_H
+#define FIRE_FIGHTER_MUSICSERVICE_H
+
+#include <SFML/Audio.hpp>
+#include <condition_variable>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "preloader.h"
+
+/**
+ * @class MusicService
+ * @brief Plays the background music and crossfades between tracks.
+ *
+ * Every track is opened once and its stream is kept for the life of the process, so switching
+ * between the menu and the game never opens or seeks a compressed stream on the main thread.
+ * prefetch() opens a track on the service's worker thread ahead of a scene change, and play()
+ * fades the current track out while the new one fades in. A track that is faded out is paused,
+ * so the menu music continues where it left off, while stop() rewinds it.
+ */
+class MusicService {
+public:
+    /**
+     * @brief Returns the single music service shared by the whole process.
+     * @return Reference to the music service.
+     */
+    static MusicService& getInstance();
+
+    /**
+     * @brief Destructor, stops the worker thread.
+     */
+    ~MusicService();
+
+    /**
+     * @brief Opens a track on the worker thread so a later play() starts without delay.
+     * @param id The asset id of the music (path relative to the project root).
+     */
+    void prefetch(const std::string& id);
+
+    /**
+     * @brief Crossfades from the current track to the given track, which loops until replaced.
+     *
+     * Does nothing if the track is already the current one. A track that has not been prefetched
+     * is opened on the calling thread.
+     *
+     * @param id The asset id of the music (path relative to the project root).
+     * @param fadeTime Duration of the crossfade.
+     */
+    void play(const std::string& id, sf::Time fadeTime = sf::seconds(1.f));
+
+    /**
+     * @brief Fades out and stops the current track, rewinding it to the beginning.
+     * @param fadeTime Duration of the fade out.
+     */
+    void stop(sf::Time fadeTime = sf::Time::Zero);
+
+private:
+    /**
+     * @brief A volume ramp applied to a track by the worker thread.
+     */
+    struct Fade {
+        sf::Music* music; ///< The track being faded.
+        float from; ///< Volume at the start of the fade.
+        float to; ///< Volume at the end of the fade.
+        sf::Time duration; ///< Duration of the fade.
+        sf::Clock clock; ///< Time since the fade started.
+        sf::SoundSource::Status endStatus; ///< Status applied to the track when the fade is over.
+    };
+
+    /**
+     * @brief Private constructor, starts the worker thread.
+     */
+    MusicService();
+
+    MusicService(const MusicService&) = delete;
+    MusicService& operator=(const MusicService&) = delete;
+
+    /**
+     * @brief Gets an open track, opening it if needed. Must be called without holding the mutex.
+     * @param id The asset id of the music.
+     * @return The track, or nullptr if it could not be opened.
+     */
+    sf::Music* acquire(const std::string& id);
+
+    /**
+     * @brief Replaces the fade of a track. Must be called while holding the mutex.
+     * @param music The track to fade.
+     * @param to The target volume.
+     * @param duration Duration of the fade.
+     * @param endStatus Status applied to the track when the fade is over.
+     */
+    void fade(sf::Music* music, float to, sf::Time duration, sf::SoundSource::Status endStatus);
+
+    /**
+     * @brief Body of the worker thread, opens prefetched tracks and advances the fades.
+     */
+    void run();
+
+    std::map<std::string, std::unique_ptr<sf::Music>> tracks; ///< Open tracks by asset id.
+    std::vector<std::string> pending; ///< Tracks waiting to be opened by the worker thread.
+    std::vector<Fade> fades; ///< Fades in progress.
+    std::string current; ///< Asset id of the track playing or fading in, empty if none.
+    bool quit; ///< Tells the worker thread to exit.
+    std::mutex mutex; ///< Guards every member above.
+    std::condition_variable wake; ///< Signals the worker thread that there is work.
+    std::thread worker; ///< The worker thread.
+};
+
+#endif //FIRE_FIGHTER_MUSICSERVICE_H
@@ -3,39 +3,44 @@
 /**
  * @author Sungmin Lee
  * constructor of player
- * @param startX Starting point in x coordinate
- * @param startY Starting point in y coordinate
- */
-Player::Player(sf::RenderWindow& window): Entity() {
-    movementSpeed = 3.0f;
-    //water-drop sound effect
-    if (!shootBuffer.loadFromFile("../../resource/sounds/water-drop.mp3")) {
-        std::cerr << "Shoot sound could not be loaded" << std::endl;
-    }
-    shootSound.setBuffer(shootBuffer);
-    options = new Settings();
+ * @param opt game settings
+ */
+Player::Player(Settings* opt): Entity() {
+    movementSpeed = 135.f;  // virtual units per second
+    //water-drop sound effect, decoded once and played through the shared voice pool
+    shootSound = SoundManager::getInstance().load("resource/sounds/water-drop.mp3", 4);
+    options = new Settings(*opt);
     lives = 3;
-    //if it is 4k, scale differently
-    if(options->getVector().x == 3840){
-        sprite.setScale(options->widthScaling(0.5f), options->heightScaling(0.5f));
-        movementSpeed *= options->widthScaling(1.0f);
-    }else{
-        sprite.setScale(options->widthScaling(1.f), options->heightScaling(1.f));
-        movementSpeed *= options->widthScaling(1.5f);
-    }
-    this->setPosition(window.getSize().x *0.93 , window.getSize().y/ 2);
+    this->setPosition(VirtualView::getSize().x * 0.93f, VirtualView::getSize().y / 2);
 }
 
 //move player's bulletSprite
-void Player::move(const sf::Vector2f& direction) {
-    sprite.move(direction * movementSpeed);
+void Player::move(const sf::Vector2f& direction, const sf::Time& delta) {
+    sprite.move(direction * movementSpeed * delta.asSeconds());
+}
+/**
+ * get the movement speed of the player
+ * @return movement speed in virtual units per second
+ */
+float Player::getMovementSpeed() const {
+    return movementSpeed;
+}
+/**
+ * record the position of the player and its bullets before a simulation tick moves them
+ */
+void Player::recordPositions() {
+    recordPosition();
+    for (auto& bullet : bullet) {
+        bullet.recordPosition();
+    }
 }
 /**
  * draw player on the window
  * @param window window
+ * @param alpha how far the frame is between the last simulation tick and the next one
  */
-void Player::draw(sf::RenderWindow& window) {
-    window.draw(sprite);
+void Player::draw(sf::RenderTarget& window, float alpha) {
+    window.draw(getInterpolatedSprite(alpha));
 }
 /**
  * set the number of player's life
@@ -92,10 +97,10 @@ sf::Vector2f Player::getSize() const {
  */
 void Player::shoot() {
     //new bullet's starting posiiton
-    Bullet newBullet(getPosition().x - getSize().x / 2, getPosition().y + getSize().y / 2, "player", options->getVector());
+    Bullet newBullet(getPosition().x - getSize().x / 2, getPosition().y + getSize().y / 2, "player", VirtualView::getResolution());
     bullet.push_back(newBullet);
     if (options->toggleSounds()) {
-        shootSound.play();
+        SoundManager::getInstance().play(shootSound);
     }
 }
 /**
@@ -124,6 +129,19 @@ void Player::updateBullets(const sf::Time& delta, EnemyWave& enemyWave, Metrics&
             ++bulletIt;
         }
     }
+    //if bullet goes off screen
+    removeBullets();
+}
+/**
+ * remove bullets that have flown past the left edge, they can not hit anything anymore
+ */
+void Player::removeBullets() {
+    for (int i = bullet.size() - 1; i >= 0; --i) {
+        sf::FloatRect bounds = bullet[i].getGlobalBounds();
+        if (bounds.left + bounds.width < 0.f) {
+            bullet.erase(bullet.begin() + i);
+        }
+    }
 }
 /**
  * Updates the bullets for collisions with barriers and shrinks the barrier upon collision.
@@ -145,12 +163,13 @@ void Player::updateBarrier(const sf::Time delta, Barrier& barrier) {
     }
 }
 /**
- * Draws all bullets shot by the player on the specified render window.
- * @param window
+ * Adds all bullets shot by the player to a batch of projectiles.
+ * @param batch The batch collecting the projectiles of the frame.
+ * @param alpha How far the frame is between the last simulation tick and the next one.
  */
-void Player::drawBullets(sf::RenderWindow& window) {
-    for (auto& bullet : bullet) {
-        bullet.draw(window,"player");
+void Player::addBulletsTo(SpriteBatch& batch, float alpha) const {
+    for (const auto& bullet : bullet) {
+        batch.add(bullet.getInterpolatedSprite(alpha));
     }
 }
 /**
@@ -161,18 +180,17 @@ Player::~Player() {
 }
 
 /**
- * Sets the texture of the player's Sprite based on the provided file path.
- * @param str file path
+ * Sets the texture of the player's Sprite based on the provided asset id.
+ * @param str asset id of the texture
  */
 void Player::setPlayerTexture(char* str) {
-    this->setTexture(str);
+    this->setTexture(str, VirtualView::getResolution());
 }
 
 /**
  * reset player's position and lives
- * @param window window
  */
-void Player::reset(sf::RenderWindow& window) {
+void Player::reset() {
     setLives(3);
-    this->setPosition(window.getSize().x *0.93 , window.getSize().y/ 2);
+    this->setPosition(VirtualView::getSize().x * 0.93f, VirtualView::getSize().y / 2);
 }
@@ -11,6 +11,7 @@
 #include <iostream>
 #include <string>
 #include "enemywave.h"
+#include "soundmanager.h"
 
 /**
  * @class Player
@@ -24,10 +25,11 @@
 class Player : public Entity {
 public:
     /**
-     * @brief Constructs a Player object with initial position and game resolution.
+     * @brief Constructs a Player object at its initial position in the virtual space.
      * Initializes player's properties such as movement speed, health, and sets up the sound effects for shooting.
+     * @param opt The game settings, copied so the player does not have to reload them from disk.
      */
-    Player(sf::RenderWindow& window);
+    explicit Player(Settings* opt);
 
     /**
      * @brief Destructor for Player, cleans up allocated resources.
@@ -57,22 +59,41 @@ public:
     void updateBarrier(const sf::Time delta, Barrier& barrier);
 
     /**
-     * @brief Draws bullets on the given render window.
-     * @param window The window where bullets will be drawn.
+     * @brief Removes bullets that have flown past the left edge of the virtual space.
      */
-    void drawBullets(sf::RenderWindow& window);
+    void removeBullets();
 
     /**
-     * @brief Moves the player in the given direction.
-     * @param direction The vector indicating direction and magnitude of the movement.
+     * @brief Adds the bullets to a batch of projectiles, which draws them with the enemy bullets.
+     * @param batch The batch collecting the projectiles of the frame.
+     * @param alpha How far the frame is between the last simulation tick and the next one, from 0 to 1.
      */
-    void move(const sf::Vector2f& direction);
+    void addBulletsTo(SpriteBatch& batch, float alpha = 1.f) const;
+
+    /**
+     * @brief Moves the player in the given direction at its movement speed.
+     * @param direction The direction of the movement, a unit vector.
+     * @param delta Time the player moves for.
+     */
+    void move(const sf::Vector2f& direction, const sf::Time& delta);
+
+    /**
+     * @brief Gets the movement speed of the player.
+     * @return The movement speed in virtual units per second.
+     */
+    float getMovementSpeed() const;
+
+    /**
+     * @brief Records the position of the player and its bullets at the start of a simulation tick.
+     */
+    void recordPositions();
 
     /**
      * @brief Draws the player Sprite on the specified window.
-     * @param window The render window to draw the player on.
+     * @param window The render target to draw the player on.
+     * @param alpha How far the frame is between the last simulation tick and the next one, from 0 to 1.
      */
-    void draw(sf::RenderWindow& window);
+    void draw(sf::RenderTarget& window, float alpha = 1.f);
 
     /**
      * @brief Gets the size of the player's bulletSprite.
@@ -104,7 +125,7 @@ public:
     /**
      * @brief Reset player's position and lives
      */
-    void reset(sf::RenderWindow& window);
+    void reset();
     /**
      * @brief Checks for collision between the player and an enemy's sprite.
      * @param enemySprite The Sprite of the enemy to check for collision.
@@ -114,15 +135,14 @@ public:
 
     /**
      * @brief Sets the texture for the player's bulletSprite.
-     * @param t The file path to the texture.
+     * @param t The asset id of the texture.
      */
     void setPlayerTexture(char *t);
 
 private:
-    float movementSpeed; ///< The player's movement speed.
+    float movementSpeed; ///< The player's movement speed in virtual units per second.
     int lives; ///< The number of lives the player has.
-    sf::SoundBuffer shootBuffer; ///< Buffer for the shooting sound effect.
-    sf::Sound shootSound; ///< Sound effect for shooting.
+    int shootSound; ///< Handle of the shooting sound effect in the SoundManager.
     Settings *options; ///< Pointer to game settings, used for sound toggling.
 };
 
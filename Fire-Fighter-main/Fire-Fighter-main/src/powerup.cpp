@@ -2,22 +2,11 @@
 
 /**
  * Constructor of the Powerup object.
+ * @param gameSettings The game settings that are set by the user.
  */
-Powerup::Powerup() {
-    // Load file and print error message if fails
-    if (!texture.loadFromFile("../../resource/img/life.png")) {
-        std::cerr << "Failed to load powerup texture" << std::endl;
-    }
-
-    // Set the texture for the powerup sprite
-    sprite.setTexture(texture);
-
-    // Adjust sprite scale based on resolution from game settings
-    if(gameSettings.getVector().x == 3840){
-        sprite.setScale(gameSettings.widthScaling(0.2f), gameSettings.heightScaling(0.2f));
-    }else{
-        sprite.setScale(gameSettings.widthScaling(1.f), gameSettings.heightScaling(1.f));
-    }
+Powerup::Powerup(Settings gameSettings) : gameSettings(gameSettings) {
+    // Acquire the shared atlas region and set it for the powerup sprite
+    reloadTexture();
 
     // Reset the powerup
     reset();
@@ -49,12 +38,12 @@ void Powerup::reset() {
 }
 
 /**
- * Update the Powerup object based on elapsed time, player interaction, and window boundaries.
+ * Update the Powerup object based on elapsed time, player interaction, and the edges of the virtual space.
  * @param delta The elapsed time since the last update.
  * @param player A pointer to the Player object for collision detection.
- * @param window The SFML render window for boundary checking.
  */
-void Powerup::update(const sf::Time& delta, Player* player, sf::RenderWindow& window) {
+void Powerup::update(const sf::Time& delta, Player* player) {
+    const sf::Vector2f bounds = VirtualView::getSize();
     if (!collected && player->getLives() < 3) { // Only update if lives < 3
         time += delta; // Increment time with elapsed delta time
 
@@ -71,26 +60,26 @@ void Powerup::update(const sf::Time& delta, Player* player, sf::RenderWindow& wi
                 collected = true;
             }
 
-            // Bounce off window walls
+            // Bounce off the walls of the virtual space
             if (sprite.getPosition().x < 0) {
                 // Change direction to move towards the right
                 direction.x = 1.f;
             }
-            else if (sprite.getPosition().x + sprite.getGlobalBounds().width > window.getSize().x) {
+            else if (sprite.getPosition().x + sprite.getGlobalBounds().width > bounds.x) {
                 // Change direction to move towards the left
                 direction.x = -1.f;
 
                 // Bounce randomly to top or bottom
                 std::random_device rd;
                 std::mt19937 gen(rd());
-                std::uniform_real_distribution<float> disY(window.getSize().y * 0.1f, window.getSize().y - sprite.getGlobalBounds().height); // Adjust Y range as needed
+                std::uniform_real_distribution<float> disY(bounds.y * 0.1f, bounds.y - sprite.getGlobalBounds().height); // Adjust Y range as needed
 
                 // Randomly choose to move up or down
                 direction.y = (std::rand() % 2 == 0) ? 1.f : -1.f;
             }
 
             // Bounce off top and bottom walls
-            if (sprite.getPosition().y < window.getSize().y * 0.1f || sprite.getPosition().y + sprite.getGlobalBounds().height > window.getSize().y) {
+            if (sprite.getPosition().y < bounds.y * 0.1f || sprite.getPosition().y + sprite.getGlobalBounds().height > bounds.y) {
                 direction.y *= -1;
             }
         }
@@ -101,11 +90,39 @@ void Powerup::update(const sf::Time& delta, Player* player, sf::RenderWindow& wi
 
 /**
  * Draw the Powerup object on the specified render window.
- * @param window The SFML render window to draw the powerup on.
+ * @param window The render target to draw the powerup on.
  * @param player A pointer to the Player object for condition checking.
+ * @param alpha How far the frame is between the last simulation tick and the next one, from 0 to 1.
  */
-void Powerup::draw(sf::RenderWindow& window, Player* player) {
+void Powerup::draw(sf::RenderTarget& window, Player* player, float alpha) {
     if (!collected && player->getLives() < 3 && time >= sf::seconds(appearanceDelay)) { // Only draw if lives < 3 and it's time to show the powerup
-        window.draw(sprite);
+        window.draw(motion.interpolate(sprite, alpha));
     }
 }
+
+/**
+ * Add the Powerup object to a batch of sprites if it is shown.
+ * @param batch The batch collecting the sprites of the frame.
+ * @param player A pointer to the Player object for condition checking.
+ * @param alpha How far the frame is between the last simulation tick and the next one, from 0 to 1.
+ */
+void Powerup::addTo(SpriteBatch& batch, Player* player, float alpha) const {
+    if (!collected && player->getLives() < 3 && time >= sf::seconds(appearanceDelay)) {
+        batch.add(motion.interpolate(sprite, alpha));
+    }
+}
+
+/**
+ * Acquire the powerup atlas region again for the current pixel density of the virtual view.
+ */
+void Powerup::reloadTexture() {
+    texture = TextureCache::getInstance().acquireRegion("resource/img/life.png", VirtualView::getResolution());
+    texture.apply(sprite);
+}
+
+/**
+ * Record the position of the powerup at the start of a simulation tick.
+ */
+void Powerup::recordPosition() {
+    motion.record(sprite);
+}
@@ -10,6 +10,10 @@
 #include <SFML/Graphics.hpp>
 #include <iostream>
 #include <random>
+#include <memory>
+#include "texturecache.h"
+#include "virtualview.h"
+#include "interpolator.h"
 #include "player.h"
 
 /**
@@ -24,11 +28,13 @@ public:
     /**
      * @brief Constructs a Powerup object.
      *
-     * Initializes a Powerup object by loading its texture from a file and setting up its sprite.
-     * The default texture for the powerup is "life.png". If the texture loading fails, an error message is printed.
-     * The sprite's scale is adjusted based on the game settings.
+     * Initializes a Powerup object by acquiring its texture from the TextureCache and setting up its sprite.
+     * The default texture for the powerup is "life.png".
+     * The sprite uses the texture variant sized for the resolution in the game settings.
+     *
+     * @param gameSettings the game settings set by the user.
      */
-    Powerup();
+    Powerup(Settings gameSettings);
 
     /**
      * @brief Destructs a Powerup object.
@@ -45,10 +51,15 @@ public:
      */
     void reset();
 
+    /**
+     * @brief Acquires the powerup texture again for the current pixel density of the virtual view.
+     */
+    void reloadTexture();
+
     /**
      * @brief Updates the Powerup object based on elapsed time, player interaction, and window boundaries.
      *
-     * This function updates the Powerup object's position, collision detection with the player, and behavior near window boundaries.
+     * This function updates the Powerup object's position, collision detection with the player, and behavior near the edges of the virtual space.
      * It checks if the powerup has been collected and if the player's lives are less than 3. If so, it updates the powerup's position
      * and checks for collision with the player. If the powerup collides with the player, the player's life is increased, and the powerup
      * is marked as collected. The powerup bounces off window walls and changes direction if it reaches the left or right edges of the window.
@@ -57,9 +68,8 @@ public:
      *
      * @param delta The elapsed time since the last update.
      * @param player A pointer to the Player object for collision detection.
-     * @param window The SFML render window for boundary checking.
      */
-    void update(const sf::Time& delta, Player* player, sf::RenderWindow& window);
+    void update(const sf::Time& delta, Player* player);
 
     /**
      * @brief Draws the Powerup object on the specified render window.
@@ -68,13 +78,28 @@ public:
      * It checks if the powerup has been collected, if the player's lives are less than 3, and if it's time
      * to show the powerup. If these conditions are satisfied, the powerup sprite is drawn on the window.
      *
-     * @param window The SFML render window to draw the powerup on.
+     * @param window The render target to draw the powerup on.
+     * @param player A pointer to the Player object for condition checking.
+     * @param alpha How far the frame is between the last simulation tick and the next one, from 0 to 1.
+     */
+    void draw(sf::RenderTarget& window, Player* player, float alpha = 1.f);
+
+    /**
+     * @brief Adds the Powerup object to a batch of sprites, under the same conditions it is drawn.
+     *
+     * @param batch The batch collecting the sprites of the frame.
      * @param player A pointer to the Player object for condition checking.
+     * @param alpha How far the frame is between the last simulation tick and the next one, from 0 to 1.
+     */
+    void addTo(SpriteBatch& batch, Player* player, float alpha = 1.f) const;
+
+    /**
+     * @brief Records the position of the powerup at the start of a simulation tick.
      */
-    void draw(sf::RenderWindow& window, Player* player);
+    void recordPosition();
 
 private:
-    sf::Texture texture; /**< The texture of the powerup sprite. */
+    TextureRegion texture; /**< Shared atlas region of the powerup sprite. */
     sf::Sprite sprite; /**< The sprite representing the powerup. */
     float speed; /**< The speed of the powerup. */
     sf::Vector2f direction; /**< The direction of movement for the powerup. */
@@ -84,6 +109,7 @@ private:
     Settings gameSettings; /**< The game settings object. */
     sf::Time time; /**< Elapsed time since the powerup appeared. */
     int appearanceDelay; /**< The delay before the powerup appears after it's created. */
+    Interpolator motion; /**< Position of the powerup at the previous simulation tick. */
 
 };
 
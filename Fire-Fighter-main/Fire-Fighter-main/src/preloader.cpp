@@ -0,0 +1,258 @@
+#include "preloader.h"
+#include <algorithm>
+
+const std::vector<std::string> Preloader::imageIds = {
+        "resource/img/fire.png",
+        "resource/img/fireball.png",
+        "resource/img/droplet.png",
+        "resource/img/iceBlock.png",
+        "resource/img/life.png",
+        "resource/img/0.png",
+        "resource/img/1.png",
+        "resource/img/2.png",
+        "resource/img/3.png",
+        "resource/img/waterBoy.png",
+        "resource/img/waterGirl.png",
+        "resource/img/character_back_drop.png"};
+
+const std::vector<std::string> Preloader::soundIds = {
+        "resource/sounds/melt.mp3",
+        "resource/sounds/water-drop.mp3"};
+
+const std::vector<std::string> Preloader::fileIds = {
+        "music/rglk2theme2distort.mp3"};
+
+/**
+ * Private constructor of the Preloader.
+ */
+Preloader::Preloader() : started(false), complete(false), loadedCount(0) {}
+
+/**
+ * Destructor of the Preloader, joins the loader thread.
+ */
+Preloader::~Preloader() {
+    if (worker.joinable()) {
+        worker.join();
+    }
+}
+
+/**
+ * Return the single preloader shared by the whole process.
+ * @return Reference to the preloader.
+ */
+Preloader& Preloader::getInstance() {
+    static Preloader instance;
+    return instance;
+}
+
+/**
+ * Start the loader thread if it has not been started yet.
+ */
+void Preloader::start() {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (started) {
+        return;
+    }
+    started = true;
+    worker = std::thread(&Preloader::run, this);
+}
+
+/**
+ * Get how much of the preload work has been done.
+ * @return A value between 0 and 1.
+ */
+float Preloader::getProgress() const {
+    std::size_t total = imageIds.size() + soundIds.size() + fileIds.size();
+    return total == 0 ? 1.f : static_cast<float>(loadedCount) / static_cast<float>(total);
+}
+
+/**
+ * Check if every asset has been preloaded.
+ * @return True if the loader thread has finished, false otherwise.
+ */
+bool Preloader::isComplete() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return complete;
+}
+
+/**
+ * Block until the loader thread has finished.
+ */
+void Preloader::wait() {
+    std::unique_lock<std::mutex> lock(mutex);
+    finished.wait(lock, [this] { return !started || complete; });
+}
+
+/**
+ * Body of the loader thread, decodes every gameplay asset into memory.
+ */
+void Preloader::run() {
+    AssetPack& pack = AssetPack::getInstance();
+    for (const auto& id : imageIds) {
+        sf::Image image;
+        if (ImageCache::getInstance().load(id, image)) {
+            std::lock_guard<std::mutex> lock(mutex);
+            images[id] = image;
+        } else {
+            std::cerr << "Failed to preload image " << id << std::endl;
+        }
+        markReady(id);
+    }
+    for (const auto& id : soundIds) {
+        sf::Clock clock;
+        auto buffer = std::make_shared<sf::SoundBuffer>();
+        if (pack.load(id, *buffer)) {
+            LoadReport::getInstance().record(LoadReport::Sound, id, clock.getElapsedTime(),
+                                             static_cast<std::size_t>(buffer->getSampleCount()) * sizeof(sf::Int16));
+            std::lock_guard<std::mutex> lock(mutex);
+            sounds[id] = buffer;
+        } else {
+            std::cerr << "Failed to preload sound " << id << std::endl;
+        }
+        markReady(id);
+    }
+    for (const auto& id : fileIds) {
+        sf::Clock clock;
+        const void* data;
+        std::size_t size;
+        if (pack.find(id, data, size)) {    // already mapped, only touch the pages
+            volatile char sum = 0;
+            for (std::size_t i = 0; i < size; i += 4096) {
+                sum += static_cast<const char*>(data)[i];
+            }
+            markReady(id);
+            continue;
+        }
+        std::ifstream file(AssetPack::getLoosePath(id), std::ios::binary);
+        if (file.is_open()) {
+            std::vector<char> contents((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+            LoadReport::getInstance().record(LoadReport::Music, id, clock.getElapsedTime(), contents.size());
+            std::lock_guard<std::mutex> lock(mutex);
+            files[id] = std::move(contents);
+        } else {
+            std::cerr << "Failed to preload file " << id << std::endl;
+        }
+        markReady(id);
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    complete = true;
+    finished.notify_all();
+}
+
+/**
+ * Mark an asset as handled by the loader thread and wake up the threads waiting for it.
+ * @param id The asset id, loaded or failed.
+ */
+void Preloader::markReady(const std::string& id) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        ready.insert(id);
+    }
+    ++loadedCount;
+    finished.notify_all();
+}
+
+/**
+ * Wait until the loader has finished the given asset, if it was started and is responsible for it.
+ * @param id The asset id about to be loaded.
+ */
+void Preloader::waitFor(const std::string& id) {
+    bool preloaded = std::find(imageIds.begin(), imageIds.end(), id) != imageIds.end() ||
+                     std::find(soundIds.begin(), soundIds.end(), id) != soundIds.end() ||
+                     std::find(fileIds.begin(), fileIds.end(), id) != fileIds.end();
+    if (!preloaded) {
+        return;
+    }
+    std::unique_lock<std::mutex> lock(mutex);
+    finished.wait(lock, [this, &id] { return !started || complete || ready.count(id) > 0; });
+}
+
+/**
+ * Load an image, using the preloaded copy when there is one.
+ * @param id The asset id of the image.
+ * @param image The image to fill.
+ * @return True if the image was loaded, false otherwise.
+ */
+bool Preloader::loadImage(const std::string& id, sf::Image& image) {
+    waitFor(id);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = images.find(id);
+        if (it != images.end()) {
+            image = it->second;
+            return true;
+        }
+    }
+    return ImageCache::getInstance().load(id, image);
+}
+
+/**
+ * Load a sound effect, handing out the preloaded buffer when there is one.
+ * @param id The asset id of the sound.
+ * @return The decoded sound, or nullptr if it could not be loaded.
+ */
+std::shared_ptr<sf::SoundBuffer> Preloader::loadSoundBuffer(const std::string& id) {
+    waitFor(id);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = sounds.find(id);
+        if (it != sounds.end()) {
+            return it->second;
+        }
+    }
+    sf::Clock clock;
+    auto buffer = std::make_shared<sf::SoundBuffer>();
+    if (!AssetPack::getInstance().load(id, *buffer)) {
+        return nullptr;
+    }
+    LoadReport::getInstance().record(LoadReport::Sound, id, clock.getElapsedTime(),
+                                     static_cast<std::size_t>(buffer->getSampleCount()) * sizeof(sf::Int16));
+    return buffer;
+}
+
+/**
+ * Open a music stream, streaming from the asset pack or the preloaded file contents.
+ * @param id The asset id of the music.
+ * @param music The music to open.
+ * @return True if the music was opened, false otherwise.
+ */
+bool Preloader::openMusic(const std::string& id, sf::Music& music) {
+    const void* data;
+    std::size_t size;
+    if (AssetPack::getInstance().find(id, data, size)) {
+        return music.openFromMemory(data, size);    // mapped, no need to wait for its pages to be touched
+    }
+    waitFor(id);
+    const std::vector<char>* contents = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = files.find(id);
+        if (it != files.end() && !it->second.empty()) {
+            contents = &it->second;
+        }
+    }
+    if (contents != nullptr) {
+        // Entries are never changed once added, so the contents stay valid after unlocking
+        return music.openFromMemory(contents->data(), contents->size());
+    }
+    return music.openFromFile(AssetPack::getLoosePath(id));
+}
+
+/**
+ * Get the memory used by the preloaded images and files.
+ * @return The size of the preloaded data in bytes, 0 while the loader thread is still running.
+ */
+std::size_t Preloader::getMemoryUsage() const {
+    if (!isComplete()) {
+        return 0;
+    }
+    std::size_t bytes = 0;
+    for (const auto& image : images) {
+        bytes += static_cast<std::size_t>(image.second.getSize().x) * image.second.getSize().y * 4;
+    }
+    for (const auto& file : files) {
+        bytes += file.second.size();
+    }
+    return bytes;
+}
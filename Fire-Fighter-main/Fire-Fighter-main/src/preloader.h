@@ -0,0 +1,146 @@
+/**
+ * @file preloader.h
+ * @brief Declaration of the Preloader class.
+ */
+
+#ifndef FIRE_FIGHTER_PRELOADER_H
+#define FIRE_FIGHTER_PRELOADER_H
+
+#include <SFML/Graphics.hpp>
+#include <SFML/Audio.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+#include "assetpack.h"
+#include "imagecache.h"
+#include "loadreport.h"
+
+/**
+ * @class Preloader
+ * @brief Decodes gameplay assets into memory on a background thread.
+ *
+ * The preloader is started while the main menu is shown. Its thread decodes the gameplay images
+ * and sound effects from the AssetPack and makes sure the gameplay music is in memory, so that
+ * entering a game does not touch the disk. Loading functions wait for the preloader when they ask for an asset it has not
+ * finished yet, only until that asset is ready, and fall back to reading the file directly for assets it does not know about.
+ */
+class Preloader {
+public:
+    /**
+     * @brief Returns the single preloader shared by the whole process.
+     * @return Reference to the preloader.
+     */
+    static Preloader& getInstance();
+
+    /**
+     * @brief Destructor, waits for the loader thread to finish.
+     */
+    ~Preloader();
+
+    /**
+     * @brief Starts the loader thread if it has not been started yet.
+     */
+    void start();
+
+    /**
+     * @brief Gets how much of the preload work has been done.
+     * @return A value between 0 and 1, where 1 means every asset has been loaded.
+     */
+    float getProgress() const;
+
+    /**
+     * @brief Checks if every asset has been preloaded.
+     * @return True if the loader thread has finished, false otherwise.
+     */
+    bool isComplete() const;
+
+    /**
+     * @brief Blocks until the loader thread has finished, returns immediately if it was never started.
+     */
+    void wait();
+
+    /**
+     * @brief Loads an image, using the preloaded copy when there is one.
+     * @param id The asset id of the image (path relative to the project root).
+     * @param image The image to fill.
+     * @return True if the image was loaded, false otherwise.
+     */
+    bool loadImage(const std::string& id, sf::Image& image);
+
+    /**
+     * @brief Loads a sound effect, handing out the preloaded buffer when there is one.
+     *
+     * Preloaded buffers are shared rather than copied, so the samples are only decoded once.
+     *
+     * @param id The asset id of the sound (path relative to the project root).
+     * @return The decoded sound, or nullptr if it could not be loaded.
+     */
+    std::shared_ptr<sf::SoundBuffer> loadSoundBuffer(const std::string& id);
+
+    /**
+     * @brief Opens a music stream, streaming from the asset pack or the preloaded file contents.
+     * @param id The asset id of the music (path relative to the project root).
+     * @param music The music to open.
+     * @return True if the music was opened, false otherwise.
+     */
+    bool openMusic(const std::string& id, sf::Music& music);
+
+    /**
+     * @brief Gets the memory used by the preloaded images and files.
+     *
+     * Preloaded sound buffers are handed to the SoundManager and counted there instead.
+     *
+     * @return The size of the preloaded data in bytes, 0 while the loader thread is still running.
+     */
+    std::size_t getMemoryUsage() const;
+
+private:
+    /**
+     * @brief Private constructor, use getInstance() to access the preloader.
+     */
+    Preloader();
+
+    Preloader(const Preloader&) = delete;
+    Preloader& operator=(const Preloader&) = delete;
+
+    /**
+     * @brief Body of the loader thread.
+     */
+    void run();
+
+    /**
+     * @brief Waits until the loader has finished the given asset, if it was started and is responsible for it.
+     * @param id The asset id about to be loaded.
+     */
+    void waitFor(const std::string& id);
+
+    /**
+     * @brief Marks an asset as handled by the loader thread and wakes up the threads waiting for it.
+     * @param id The asset id, loaded or failed.
+     */
+    void markReady(const std::string& id);
+
+    std::thread worker; ///< The loader thread.
+    mutable std::mutex mutex; ///< Guards the flags, the ready set and the maps of preloaded assets.
+    std::condition_variable finished; ///< Signalled when an asset is ready and when the loader thread is done.
+    bool started; ///< Flag indicating whether the loader thread was started.
+    bool complete; ///< Flag indicating whether the loader thread is done.
+    std::atomic<unsigned> loadedCount; ///< Number of assets handled so far.
+    std::set<std::string> ready; ///< Asset ids the loader thread is done with, loaded or failed.
+    std::map<std::string, sf::Image> images; ///< Decoded images by asset id.
+    std::map<std::string, std::shared_ptr<sf::SoundBuffer>> sounds; ///< Decoded sound effects by asset id.
+    std::map<std::string, std::vector<char>> files; ///< Raw file contents by asset id, when not in the pack.
+    static const std::vector<std::string> imageIds; ///< Images decoded by the loader thread.
+    static const std::vector<std::string> soundIds; ///< Sound effects decoded by the loader thread.
+    static const std::vector<std::string> fileIds; ///< Files kept in memory for streaming.
+};
+
+#endif //FIRE_FIGHTER_PRELOADER_H
@@ -0,0 +1,109 @@
+#include "renderthread.h"
+#include <utility>
+
+/**
+ * Remove everything from the snapshot, keeping the allocated storage.
+ */
+void RenderSnapshot::clear() {
+    scene.clear();
+    shapes.clear();
+    sprites.clear();
+    texts.clear();
+}
+
+/**
+ * Construct a stopped render thread.
+ */
+RenderThread::RenderThread()
+        : window(nullptr), front(0), ready(1), back(2), fresh(false), stopping(false), running(false) {}
+
+/**
+ * Destructor of the RenderThread, stops the thread if it runs.
+ */
+RenderThread::~RenderThread() {
+    stop();
+}
+
+/**
+ * Start drawing published snapshots to a window.
+ * @param window The window to draw to, owned by the render thread until stop().
+ * @param draw Draws a snapshot to the window and displays it, called on the render thread.
+ */
+void RenderThread::start(sf::RenderWindow& window, std::function<void(const RenderSnapshot&)> draw) {
+    if (running) {
+        return;
+    }
+    this->window = &window;
+    drawFrame = std::move(draw);
+    fresh = false;
+    stopping = false;
+    window.setActive(false);    // a context can only be active on one thread
+    running = true;
+    worker = std::thread(&RenderThread::run, this);
+}
+
+/**
+ * Stop the render thread and give the window back to the calling thread.
+ */
+void RenderThread::stop() {
+    if (!running) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    changed.notify_all();
+    worker.join();
+    running = false;
+    window->setActive(true);
+}
+
+/**
+ * Check if the render thread runs.
+ * @return True between start() and stop().
+ */
+bool RenderThread::isRunning() const {
+    return running;
+}
+
+/**
+ * Get the snapshot to fill for the next frame.
+ * @return The back buffer.
+ */
+RenderSnapshot& RenderThread::acquire() {
+    return buffers[back];
+}
+
+/**
+ * Hand the filled snapshot to the render thread, once it picked up the previous one.
+ */
+void RenderThread::publish() {
+    std::unique_lock<std::mutex> lock(mutex);
+    changed.wait(lock, [this] { return !fresh || stopping; });
+    std::swap(back, ready);
+    fresh = true;
+    lock.unlock();
+    changed.notify_all();
+}
+
+/**
+ * Body of the render thread, draws the latest snapshot whenever one is published.
+ */
+void RenderThread::run() {
+    window->setActive(true);
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            changed.wait(lock, [this] { return fresh || stopping; });
+            if (stopping) {
+                break;
+            }
+            std::swap(front, ready);
+            fresh = false;
+        }
+        changed.notify_all();   // the game can publish the next snapshot
+        drawFrame(buffers[front]);
+    }
+    window->setActive(false);
+}
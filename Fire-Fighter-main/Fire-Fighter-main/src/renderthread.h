@@ -0,0 +1,118 @@
+/**
+ * @file renderthread.h
+ * @brief Declaration of the RenderSnapshot struct and the RenderThread class.
+ */
+
+#ifndef FIRE_FIGHTER_RENDERTHREAD_H
+#define FIRE_FIGHTER_RENDERTHREAD_H
+
+#include <SFML/Graphics.hpp>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "spritebatch.h"
+
+/**
+ * @struct RenderSnapshot
+ * @brief Everything one frame draws, copied out of the game so another thread can draw it.
+ *
+ * A snapshot only holds copies: the vertices of the world sprites, and the shapes, sprites and texts of
+ * the HUD. Textures and fonts are referenced, not copied, they are not modified while the game runs.
+ */
+struct RenderSnapshot {
+    SpriteBatch scene; ///< Sprites of the gameplay world in drawing order, drawn at the dynamic resolution.
+    std::vector<sf::RectangleShape> shapes; ///< Bars and panels of the HUD and the stage banner.
+    std::vector<sf::Sprite> sprites; ///< Sprites of the HUD, drawn over the shapes.
+    std::vector<sf::Text> texts; ///< Texts of the HUD and the stage banner, drawn last.
+
+    /**
+     * @brief Removes everything from the snapshot, keeping the allocated storage.
+     */
+    void clear();
+};
+
+/**
+ * @class RenderThread
+ * @brief Draws frames on a thread of its own, while the game simulates the next one.
+ *
+ * The game thread fills a snapshot of the frame and publishes it; the render thread owns the window
+ * while it runs and draws the latest published snapshot, so waiting for the display does not take
+ * time from the simulation. Snapshots are triple buffered: the render thread draws one, the latest
+ * published one waits in the second, and the game fills the third, so neither thread ever waits for
+ * the other to finish with a buffer. The game stays at most one frame ahead: publishing waits until
+ * the render thread picked up the previous snapshot.
+ *
+ * Anything else that draws to the window, loads glyphs or resizes the window has to stop the render
+ * thread first, SFML windows and fonts are not meant to be used by two threads at once.
+ */
+class RenderThread {
+public:
+    /**
+     * @brief Constructs a stopped render thread.
+     */
+    RenderThread();
+
+    /**
+     * @brief Destructor, stops the render thread if it runs.
+     */
+    ~RenderThread();
+
+    /**
+     * @brief Starts drawing published snapshots to a window, does nothing if the thread already runs.
+     *
+     * The window is deactivated on the calling thread and activated on the render thread.
+     *
+     * @param window The window to draw to, owned by the render thread until stop().
+     * @param draw Draws a snapshot to the window and displays it, called on the render thread.
+     */
+    void start(sf::RenderWindow& window, std::function<void(const RenderSnapshot&)> draw);
+
+    /**
+     * @brief Stops the render thread and gives the window back to the calling thread.
+     *
+     * A snapshot that was published but not drawn yet is dropped. Does nothing if the thread is not running.
+     */
+    void stop();
+
+    /**
+     * @brief Checks if the render thread runs.
+     * @return True between start() and stop().
+     */
+    bool isRunning() const;
+
+    /**
+     * @brief Gets the snapshot to fill for the next frame.
+     * @return The back buffer, only used by the game thread until publish().
+     */
+    RenderSnapshot& acquire();
+
+    /**
+     * @brief Hands the filled snapshot to the render thread.
+     *
+     * Waits until the render thread picked up the previously published snapshot.
+     */
+    void publish();
+
+private:
+    /**
+     * @brief Body of the render thread.
+     */
+    void run();
+
+    sf::RenderWindow* window; ///< The window drawn to.
+    std::function<void(const RenderSnapshot&)> drawFrame; ///< Draws a snapshot to the window.
+    std::thread worker; ///< The render thread.
+    std::mutex mutex; ///< Guards the buffer indices and the flags.
+    std::condition_variable changed; ///< Signalled when a snapshot was published or picked up, or on stop.
+    RenderSnapshot buffers[3]; ///< Snapshots being drawn, waiting and being filled.
+    int front; ///< Index of the snapshot the render thread draws.
+    int ready; ///< Index of the latest published snapshot.
+    int back; ///< Index of the snapshot the game fills.
+    bool fresh; ///< Flag indicating whether the ready snapshot was not drawn yet.
+    bool stopping; ///< Flag telling the render thread to finish.
+    bool running; ///< Flag indicating whether the render thread was started.
+};
+
+#endif //FIRE_FIGHTER_RENDERTHREAD_H
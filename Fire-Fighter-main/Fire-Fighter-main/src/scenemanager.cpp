@@ -0,0 +1,102 @@
+#include "scenemanager.h"
+
+const std::map<Scene, std::vector<SceneManager::SceneAsset>> SceneManager::manifests = [] {
+    // Sprites drawn by the game objects, shared by the game and the screens drawn over it
+    std::vector<SceneAsset> gameplay = {
+            {SceneAsset::Sprite, "resource/img/fire.png"},
+            {SceneAsset::Sprite, "resource/img/fireball.png"},
+            {SceneAsset::Sprite, "resource/img/droplet.png"},
+            {SceneAsset::Sprite, "resource/img/iceBlock.png"},
+            {SceneAsset::Sprite, "resource/img/life.png"},
+            {SceneAsset::Sprite, "resource/img/0.png"},
+            {SceneAsset::Sprite, "resource/img/1.png"},
+            {SceneAsset::Sprite, "resource/img/2.png"},
+            {SceneAsset::Sprite, "resource/img/3.png"},
+            {SceneAsset::Sprite, "resource/img/waterBoy.png"},
+            {SceneAsset::Sprite, "resource/img/waterGirl.png"}};
+    return std::map<Scene, std::vector<SceneAsset>>{
+            {Scene::Menu, {{SceneAsset::Backdrop, "resource/img/menu_background.jpg"}}},
+            {Scene::Settings, {}},
+            {Scene::CharacterSelect, {{SceneAsset::Texture, "resource/img/waterBoy.png"},
+                                      {SceneAsset::Texture, "resource/img/waterGirl.png"},
+                                      {SceneAsset::Texture, "resource/img/character_back_drop.png"}}},
+            {Scene::Gameplay, gameplay},
+            {Scene::Pause, gameplay},
+            {Scene::GameOver, gameplay}};
+}();
+
+/**
+ * Private constructor of the SceneManager.
+ */
+SceneManager::SceneManager() : scene(Scene::Menu) {}
+
+/**
+ * Return the single scene manager shared by the whole process.
+ * @return Reference to the scene manager.
+ */
+SceneManager& SceneManager::getInstance() {
+    static SceneManager instance;
+    return instance;
+}
+
+/**
+ * Make the assets of a scene resident and evict assets no scene needs anymore.
+ * @param next The scene being entered.
+ * @param resolution The resolution of the game, selecting the size of backdrops.
+ */
+void SceneManager::enterScene(Scene next, sf::Vector2u resolution) {
+    TextureCache& cache = TextureCache::getInstance();
+
+    // Acquire the new scene's textures while the old ones are still held, so shared ones stay loaded
+    std::vector<std::shared_ptr<const sf::Texture>> incoming;
+    for (const auto& asset : manifests.at(next)) {
+        switch (asset.kind) {
+            case SceneAsset::Texture:
+                incoming.push_back(cache.acquire(asset.id));
+                break;
+            case SceneAsset::Backdrop:
+                incoming.push_back(cache.acquire(asset.id, resolution));
+                break;
+            case SceneAsset::Sprite:
+                incoming.push_back(cache.acquireRegion(asset.id, VirtualView::getResolution()).texture);
+                break;
+        }
+    }
+
+    resident.swap(incoming);
+    incoming.clear();
+    cache.purge();
+    scene = next;
+    LoadReport::getInstance().print(getSceneName(next));
+}
+
+/**
+ * Get the name of a scene as printed in the load report.
+ * @param scene The scene.
+ * @return The name of the scene.
+ */
+const char* SceneManager::getSceneName(Scene scene) {
+    switch (scene) {
+        case Scene::Menu:
+            return "menu";
+        case Scene::Settings:
+            return "settings";
+        case Scene::CharacterSelect:
+            return "character select";
+        case Scene::Gameplay:
+            return "gameplay";
+        case Scene::Pause:
+            return "pause";
+        case Scene::GameOver:
+            return "game over";
+    }
+    return "";
+}
+
+/**
+ * Get the scene entered last.
+ * @return The current scene.
+ */
+Scene SceneManager::getScene() const {
+    return scene;
+}
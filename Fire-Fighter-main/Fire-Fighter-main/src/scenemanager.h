@@ -0,0 +1,101 @@
+/**
+ * @file scenemanager.h
+ * @brief Declaration of the SceneManager class and the Scene enumeration.
+ */
+
+#ifndef FIRE_FIGHTER_SCENEMANAGER_H
+#define FIRE_FIGHTER_SCENEMANAGER_H
+
+#include <SFML/Graphics.hpp>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include "texturecache.h"
+#include "loadreport.h"
+#include "virtualview.h"
+
+/**
+ * @brief The screens of the game, each with its own asset manifest.
+ */
+enum class Scene {
+    Menu, ///< Main menu.
+    Settings, ///< Settings window.
+    CharacterSelect, ///< Character selection screen.
+    Gameplay, ///< The game itself.
+    Pause, ///< Exit prompt drawn over the game.
+    GameOver ///< Game over screen drawn over the game.
+};
+
+/**
+ * @class SceneManager
+ * @brief Keeps the textures of the current scene resident and evicts the rest on scene changes.
+ *
+ * Every scene declares the textures it draws in a manifest. Entering a scene first acquires every
+ * texture in the new manifest, which is free for textures the previous scene already held, and only
+ * then lets go of the previous scene's textures and purges the TextureCache. Textures shared by both
+ * scenes therefore stay on the GPU, and textures still referenced by live game objects are never
+ * evicted, since the cache only drops what nothing else holds.
+ *
+ * After every scene change the LoadReport lists what the change had to load and what stays resident.
+ */
+class SceneManager {
+public:
+    /**
+     * @brief Returns the single scene manager shared by the whole process.
+     * @return Reference to the scene manager.
+     */
+    static SceneManager& getInstance();
+
+    /**
+     * @brief Makes the assets of a scene resident and evicts assets no scene needs anymore.
+     * @param next The scene being entered.
+     * @param resolution The resolution of the game, selecting the size of backdrops. Sprites are sized for the pixel density of the virtual view.
+     */
+    void enterScene(Scene next, sf::Vector2u resolution);
+
+    /**
+     * @brief Gets the scene entered last.
+     * @return The current scene.
+     */
+    Scene getScene() const;
+
+    /**
+     * @brief Gets the name of a scene as printed in the load report.
+     * @param scene The scene.
+     * @return The name of the scene.
+     */
+    static const char* getSceneName(Scene scene);
+
+private:
+    /**
+     * @brief An entry of a scene manifest.
+     */
+    struct SceneAsset {
+        /**
+         * @brief How the image is used by the scene.
+         */
+        enum Kind {
+            Texture, ///< Standalone texture at the size of the image on disk.
+            Backdrop, ///< Standalone texture resized to the resolution.
+            Sprite ///< Gameplay sprite from the atlas for the resolution.
+        };
+        Kind kind; ///< How the image is used.
+        std::string id; ///< The asset id of the image.
+    };
+
+    /**
+     * @brief Private constructor, use getInstance() to access the scene manager.
+     */
+    SceneManager();
+
+    SceneManager(const SceneManager&) = delete;
+    SceneManager& operator=(const SceneManager&) = delete;
+
+    Scene scene; ///< The scene entered last.
+    std::vector<std::shared_ptr<const sf::Texture>> resident; ///< Textures held for the current scene.
+    static const std::map<Scene, std::vector<SceneAsset>> manifests; ///< Assets declared by every scene.
+};
+
+#endif //FIRE_FIGHTER_SCENEMANAGER_H
@@ -4,6 +4,7 @@
  * Constructor of a Settings object.
  */
 Settings::Settings() {
+    font = &FontService::getInstance().acquire("resource/fonts/Rajdhani-SemiBold.ttf");  // English until the file is read
     std::ifstream file("../../config/settings.txt");             // Open the file
     char idx = 0;
     if (!file.is_open()) {
@@ -12,7 +13,7 @@ Settings::Settings() {
     }
     // Read and print each line of the file
     std::string line;
-    while (std::getline(file, line)) {
+    while (idx < 10 && std::getline(file, line)) {
         int number = std::stoi(line, nullptr, 2);     // Convert the line to an integer
         dataFromFile[idx++] = number;   // Assign the value to the data array
     }
@@ -26,25 +27,20 @@ Settings::Settings() {
     music = dataFromFile[4];
     soundEffects = dataFromFile[5];
     language = dataFromFile[6] == 1 ? lang.English : dataFromFile[6] == 2 ? lang.Korean : lang.Mandarin;
+    textureBudget = dataFromFile[7];    // missing in older settings files, which means no budget
+    vsync = dataFromFile[8];            // missing in older settings files, which means no vsync
+    renderThread = dataFromFile[9];     // missing in older settings files, which means one thread
 
-    // Load the appropriate font based on the selected language
-    if (language[0] == L"\uC0C8 \uAC8C\uC784") {
-        if (!font.loadFromFile("../../resource/fonts/NanumMyeongjoBold.ttf")) {
-            std::cerr << "Failed to load Korean font!" << std::endl;   // Print error message if Korean font loading fails
-        }
-    } else if (language[0] == L"\u65B0\u6E38\u620F") {
-        if (!font.loadFromFile("../../resource/fonts/simplified_Chinese.ttf")) {
-            std::cerr << "Failed to load Chinese font!" << std::endl;    // Print error message if Chinese font loading fails
-        }
-    } else {
-        if (!font.loadFromFile("../../resource/fonts/Rajdhani-SemiBold.ttf")) {
-            std::cerr << "Failed to load English font!" << std::endl;   // Print error message if English font loading fails
-        }
-    }
+    // Use the shared font of the selected language
+    font = &FontService::getInstance().acquire(getFontId());
 
     // Load the application icon
-    if (!icon.loadFromFile("../../resource/img/icon.png")) {
+    sf::Clock clock;
+    if (!AssetPack::getInstance().load("resource/img/icon.png", icon)) {
         std::cerr << "Failed to load icon" << std::endl;  // Print error message
+    } else {
+        LoadReport::getInstance().record(LoadReport::Image, "resource/img/icon.png", clock.getElapsedTime(),
+                                         static_cast<std::size_t>(icon.getSize().x) * icon.getSize().y * 4, icon.getSize());
     }
 }
 
@@ -60,18 +56,19 @@ void Settings::openSettings() {
     // Create the window
     sf::VideoMode fullScreenMode = sf::VideoMode::getDesktopMode();
     sf::RenderWindow window(fullscreen ? fullScreenMode : sf::VideoMode(resolution[0], resolution[1]), "Fire Fighter", fullscreen || resolution[0] >= fullScreenMode.width ? sf::Style::Fullscreen : sf::Style::Default);
-    window.setFramerateLimit(60); // Limit the frame rate to 60 FPS
+    FramePacer pacer;
+    pacer.configure(window, getFrameRate(), vsync); // Pace the frames at the configured frame rate
     window.setIcon(icon.getSize().x, icon.getSize().y, icon.getPixelsPtr()); // Set the window icon
 
     // create text for languages to display on top of the buttons
     sf::String selectLanguagesString = language[9];
-    sf::Text selectLanguagesText(selectLanguagesString, font, 20);
+    TextLabel selectLanguagesText(selectLanguagesString, *font, 20);
     selectLanguagesText.setFillColor(sf::Color::White);
     selectLanguagesText.setStyle(sf::Text::Bold);
 
     // create text for resolution to display on top of the buttons
     sf::String selectResolutionString = language[10];
-    sf::Text selectResolutionText(selectResolutionString, font, 20);
+    TextLabel selectResolutionText(selectResolutionString, *font, 20);
     selectResolutionText.setFillColor(sf::Color::White);
     selectResolutionText.setStyle(sf::Text::Bold);
 
@@ -148,32 +145,32 @@ void Settings::openSettings() {
     }
 
     // Adjusting the position and creating text for language buttons. Colors set to RGB(235, 70, 60)
-    sf::Text englishText("English", font, 20);
+    TextLabel englishText("English", *font, 20);
     englishText.setPosition(EnglishButton.getPosition().x + 20, EnglishButton.getPosition().y + 10);
     englishText.setFillColor(sf::Color(235, 70, 60));
 
-    sf::Text koreanText("Korean", font, 20);
+    TextLabel koreanText("Korean", *font, 20);
     koreanText.setPosition(koreanButton.getPosition().x + 20, koreanButton.getPosition().y + 10);
     koreanText.setFillColor(sf::Color(235, 70, 60));
 
-    sf::Text mandarinText("Mandarin", font, 20);
+    TextLabel mandarinText("Mandarin", *font, 20);
     mandarinText.setPosition(MandarinButton.getPosition().x + 20, MandarinButton.getPosition().y + 10);
     mandarinText.setFillColor(sf::Color(235, 70, 60));
 
     // Adjusting the position and creating text for resolution buttons. Colors set to RGB(235, 70, 60)
-    sf::Text dvText("640:360", font, 20);
+    TextLabel dvText("640:360", *font, 20);
     dvText.setPosition(dvButton.getPosition().x + 20, dvButton.getPosition().y + 10);
     dvText.setFillColor(sf::Color(235, 70, 60));
 
-    sf::Text sdText("1280:720", font, 20);
+    TextLabel sdText("1280:720", *font, 20);
     sdText.setPosition(sdButton.getPosition().x + 16, sdButton.getPosition().y + 10);
     sdText.setFillColor(sf::Color(235, 70, 60));
 
-    sf::Text hdText("1920:1080", font, 20);
+    TextLabel hdText("1920:1080", *font, 20);
     hdText.setPosition(hdButton.getPosition().x + 11, hdButton.getPosition().y + 10);
     hdText.setFillColor(sf::Color(235, 70, 60));
 
-    sf::Text uhdText("3840:2160", font, 20);
+    TextLabel uhdText("3840:2160", *font, 20);
     uhdText.setPosition(uhdButton.getPosition().x + 5, uhdButton.getPosition().y + 10);
     uhdText.setFillColor(sf::Color(235, 70, 60));
 
@@ -196,22 +193,22 @@ void Settings::openSettings() {
     rotationButton.setPosition(startX + (soundEffectsButton.getSize().x + buttonSpacing) * 3, startY);
 
     sf::String fullscreenString = language[3];
-    sf::Text fullscreenText(fullscreenString, font, 20);
+    TextLabel fullscreenText(fullscreenString, *font, 20);
     sf::String musicString = language[4];
-    sf::Text musicText(musicString, font, 20);
+    TextLabel musicText(musicString, *font, 20);
     sf::String soundEffectsString = language[5];
-    sf::Text soundEffectsText(soundEffectsString, font, 20);
+    TextLabel soundEffectsText(soundEffectsString, *font, 20);
     sf::String rotationString = language[6];
-    sf::Text rotationText(rotationString, font, 20);
+    TextLabel rotationText(rotationString, *font, 20);
     sf::String onString = language[7];
     sf::String offString = language[8];
-    sf::Text screenOnOffText(fullscreen ? onString : offString, font, 20);
+    TextLabel screenOnOffText(fullscreen ? onString : offString, *font, 20);
     screenOnOffText.setFillColor(sf::Color(235, 70, 60));
-    sf::Text musicOnOffText(music ? onString : offString, font, 20);
+    TextLabel musicOnOffText(music ? onString : offString, *font, 20);
     musicOnOffText.setFillColor(sf::Color(235, 70, 60));
-    sf::Text soundOnOffText(soundEffects ? onString : offString, font, 20);
+    TextLabel soundOnOffText(soundEffects ? onString : offString, *font, 20);
     soundOnOffText.setFillColor(sf::Color(235, 70, 60));
-    sf::Text rotationOnOffText(rotation ? onString : offString, font, 20);
+    TextLabel rotationOnOffText(rotation ? onString : offString, *font, 20);
     rotationOnOffText.setFillColor(sf::Color(235, 70, 60));
 
     // Set position for text
@@ -242,10 +239,10 @@ void Settings::openSettings() {
     cancelButton.setPosition(startX + applyButton.getSize().x + buttonSpacing, startY);
 
     sf::String applyString = language[11];
-    sf::Text applyText(applyString, font, 20);
+    TextLabel applyText(applyString, *font, 20);
     applyButton.setFillColor(sf::Color::Green);
     sf::String cancelString = language[12];
-    sf::Text cancelText(cancelString, font, 20);
+    TextLabel cancelText(cancelString, *font, 20);
     cancelButton.setFillColor(sf::Color(235, 70, 60));
 
     // Set position apply and cancel text
@@ -254,10 +251,11 @@ void Settings::openSettings() {
     applyText.setPosition(applyButton.getPosition().x + textOffsetX, applyButton.getPosition().y + textOffsetY);
     cancelText.setPosition(cancelButton.getPosition().x + textOffsetX, cancelButton.getPosition().y + textOffsetY);
 
-    // settings window loop
+    // settings window loop, redrawn only after input
+    MenuEventQueue events(window);
     while (window.isOpen()) {
         sf::Event event;
-        while (window.pollEvent(event)) {
+        while (events.poll(event)) {
             if (event.type == sf::Event::Closed) {
                 window.close();
             }
@@ -333,29 +331,14 @@ void Settings::openSettings() {
                     dataFromFile[4] = (music) ? 1 : 0;
                     dataFromFile[5] = (soundEffects) ? 1 : 0;
                     dataFromFile[6] = language == lang.English ? 1 : language == lang.Korean ? 2 : 3;
-                    if (language[0] == L"\uC0C8 \uAC8C\uC784") {
-                        if (!font.loadFromFile("../../resource/fonts/NanumMyeongjoBold.ttf")) {
-                            std::cerr << "Failed to load font!" << std::endl;
-                            return;
-                        }
-                    } else if (language[0] == L"\u65B0\u6E38\u620F") {
-                        if (!font.loadFromFile("../../resource/fonts/simplified_Chinese.ttf")) {
-                            std::cerr << "Failed to load font!" << std::endl;
-                            return;
-                        }
-                    } else {
-                        if (!font.loadFromFile("../../resource/fonts/Rajdhani-SemiBold.ttf")) {
-                            std::cerr << "Failed to load font!" << std::endl;
-                            return;
-                        }
-                    }
+                    font = &FontService::getInstance().acquire(getFontId());
                     // Open file in write mode, automatically overrides the file
                     std::ofstream file("../../config/settings.txt", std::ios::out);
                     if (!file) {
                         std::cerr << "Failed to open file for writing.\n";
                         return;
                     }
-                    for (size_t i = 0; i < 7; ++i) {
+                    for (size_t i = 0; i < 10; ++i) {
                         // Convert the integer to a musicString
                         std::string binaryString = std::bitset<8>(dataFromFile[i]).to_string();
                         binaryString = binaryString.substr(0);
@@ -412,6 +395,8 @@ void Settings::openSettings() {
         window.draw(applyText);
         window.draw(cancelText);
         window.display();
+        pacer.wait();       // keep bursts of input from redrawing faster than the frame rate
+        events.wait();      // sleep until the next input
     }
 }
 
@@ -449,10 +434,51 @@ bool Settings::isFullScreen() const {
 
 /**
  * Get the font used for rendering text in the application.
- * @return sf::Font The font used for rendering text.
+ * @return const sf::Font& The shared font used for rendering text.
+ */
+const sf::Font& Settings::getFont() const {
+    return *font;
+}
+
+/**
+ * Rasterize the glyphs of the selected language at every character size the game uses.
  */
-sf::Font Settings::getFont() {
-    return font;
+void Settings::prewarmFont() {
+    // Every string of the language plus digits and the ASCII labels of the settings screen
+    sf::String characters = "0123456789:";
+    for (char c = ' '; c <= '~'; ++c) {
+        characters += sf::String(static_cast<sf::Uint32>(c));
+    }
+    for (const auto& text : lang.English) {
+        characters += text;
+    }
+    for (int i = 0; i < 27; ++i) {
+        characters += language[i];
+    }
+
+    // Sizes of the settings screen, the menu, the game screens and the metrics bar
+    std::vector<unsigned> sizes = {20,
+                                   static_cast<unsigned>(widthScaling(24)),
+                                   static_cast<unsigned>(widthScaling(26)),
+                                   static_cast<unsigned>(widthScaling(28)),
+                                   static_cast<unsigned>(widthScaling(48)),
+                                   static_cast<unsigned>(widthScaling(50)),
+                                   static_cast<unsigned>(widthScaling(70)),
+                                   static_cast<unsigned>(heightScaling(20))};
+    FontService::getInstance().prewarm(getFontId(), characters, sizes);
+}
+
+/**
+ * Get the asset id of the font for the selected language.
+ * @return The asset id of the font.
+ */
+std::string Settings::getFontId() const {
+    if (language[0] == L"\uC0C8 \uAC8C\uC784") {
+        return "resource/fonts/NanumMyeongjoBold.ttf";
+    } else if (language[0] == L"\u65B0\u6E38\u620F") {
+        return "resource/fonts/simplified_Chinese.ttf";
+    }
+    return "resource/fonts/Rajdhani-SemiBold.ttf";
 }
 
 /**
@@ -498,6 +524,46 @@ sf::Vector2u Settings::getVector() {
     return vector;
 }
 
+/**
+ * Get the memory budget of the texture cache.
+ * @return The budget in bytes, 0 if there is none.
+ */
+std::size_t Settings::getTextureBudget() const {
+    return static_cast<std::size_t>(textureBudget) * 16 * 1024 * 1024;
+}
+
+/**
+ * Get the frame rate the game is paced at.
+ * @return The target frame rate in frames per second, 0 for uncapped.
+ */
+unsigned Settings::getFrameRate() const {
+    return static_cast<unsigned>(std::max(frameRate, 0));
+}
+
+/**
+ * Check if vertical sync is enabled.
+ * @return True if frames are synchronized with the refresh of the display.
+ */
+bool Settings::isVsync() const {
+    return vsync;
+}
+
+/**
+ * Turn off the music and the sound effects for this run only.
+ */
+void Settings::disableAudio() {
+    music = false;
+    soundEffects = false;
+}
+
+/**
+ * Check if the game draws its frames on a separate render thread.
+ * @return True if the simulation and the drawing run on two threads.
+ */
+bool Settings::isRenderThreaded() const {
+    return renderThread;
+}
+
 /**
  * Set a custom screen resolution.
  * @param x The width of the custom resolution.
@@ -6,6 +6,14 @@
 #include <fstream>
 #include <string>
 #include <bitset>
+#include <algorithm>
+#include <vector>
+#include "assetpack.h"
+#include "fontservice.h"
+#include "loadreport.h"
+#include "textlayoutcache.h"
+#include "menueventqueue.h"
+#include "framepacer.h"
 
 /**
  * @file settings.h
@@ -99,11 +107,21 @@ public:
     /**
      * @brief Get the font used for rendering text in the application.
      *
-     * This function returns the font used for rendering text in the application.
+     * This function returns the font of the selected language. The font is owned by the
+     * FontService, so every copy of the settings shares the same font and its glyphs.
      *
-     * @return sf::Font The font used for rendering text.
+     * @return const sf::Font& The shared font used for rendering text.
      */
-    sf::Font getFont();
+    const sf::Font& getFont() const;
+
+    /**
+     * @brief Rasterize the glyphs of the selected language at every character size the game uses.
+     *
+     * This function renders the characters of the selected language ahead of time at the sizes used
+     * by the menus and the metrics bar for the current resolution, so a new digit in the score does
+     * not have to be rasterized in the middle of a game.
+     */
+    void prewarmFont();
 
     /**
      * @brief Get the icon used for the application window.
@@ -143,6 +161,45 @@ public:
      */
     sf::Vector2u getVector();
 
+    /**
+     * @brief Get the memory budget of the texture cache.
+     *
+     * The budget is stored on the eighth line of the settings file in steps of 16 MB, so low memory
+     * machines can be limited without recompiling. 0 means the cache is unlimited.
+     *
+     * @return std::size_t The budget in bytes, 0 if there is none.
+     */
+    std::size_t getTextureBudget() const;
+
+    /**
+     * @brief Get the frame rate the game is paced at.
+     *
+     * The frame rate is stored on the third line of the settings file, e.g. 60, 120 or 144.
+     * 0 leaves the frame rate uncapped.
+     *
+     * @return unsigned The target frame rate in frames per second, 0 for uncapped.
+     */
+    unsigned getFrameRate() const;
+
+    /**
+     * @brief Check if vertical sync is enabled.
+     *
+     * Vertical sync is stored on the ninth line of the settings file, 1 to enable it.
+     *
+     * @return bool True if frames are synchronized with the refresh of the display.
+     */
+    bool isVsync() const;
+
+    /**
+     * @brief Check if the game draws its frames on a separate render thread.
+     *
+     * The render thread is enabled on the tenth line of the settings file, 1 to enable it.
+     * The game then simulates the next frame while the previous one is drawn.
+     *
+     * @return bool True if the simulation and the drawing run on two threads.
+     */
+    bool isRenderThreaded() const;
+
     /**
      * @brief Set a custom screen resolution.
      *
@@ -153,6 +210,13 @@ public:
      */
     void userScreenInfo(int x, int y);
 
+    /**
+     * @brief Turn off the music and the sound effects, without saving it to the settings file.
+     *
+     * Used by the headless benchmark, which runs on machines without an audio device.
+     */
+    void disableAudio();
+
 private:
     /**
      * @brief A nested class representing different pairs of resolutions.
@@ -165,15 +229,18 @@ private:
         int uhd[2] = {3840, 2160}; /**< Resolution for UHD (3840x2160). */
         int uniqueRes[2]; /**< Array to store a unique resolution. */
     } res; /**< Instance of the resolutionPairs class. */
-    int dataFromFile[7]{}; /**< Array to store data read from a file. */
+    int dataFromFile[10]{}; /**< Array to store data read from a file. */
     bool fullscreen; /**< Flag indicating whether the game is in fullscreen mode. */
     int *resolution; /**< Pointer to an array representing the resolution. */
     int frameRate; /**< Frame rate of the game. */
     int rotation; /**< Rotation setting of the game. */
     bool music; /**< Flag indicating whether music is enabled. */
     bool soundEffects; /**< Flag indicating whether sound effects are enabled. */
+    int textureBudget = 0; /**< Memory budget of the texture cache in steps of 16 MB, 0 for none. */
+    bool vsync = false; /**< Flag indicating whether vertical sync is enabled. */
+    bool renderThread = false; /**< Flag indicating whether frames are drawn on a separate render thread. */
     sf::String *language; /**< Pointer to an array representing the selected language. */
-    sf::Font font; /**< Font used for text rendering. */
+    const sf::Font* font; /**< Shared font used for text rendering, owned by the FontService. */
     sf::Image icon; /**< Image used for the application icon. */
 
     /**
@@ -230,6 +297,13 @@ private:
      * @return An sf::RectangleShape object representing the rectangle.
      */
     sf::RectangleShape createRectangle(float width, float height);
+
+    /**
+     * @brief Get the asset id of the font for the selected language.
+     *
+     * @return The asset id of the font.
+     */
+    std::string getFontId() const;
 };
 
 #endif //FIRE_FIGHTER_SETTINGS_H
@@ -0,0 +1,120 @@
+#include "soundmanager.h"
+
+/**
+ * Private constructor of the SoundManager.
+ */
+SoundManager::SoundManager() : playCounter(0) {
+    voiceEffect.fill(-1);
+    voiceStarted.fill(0);
+}
+
+/**
+ * Return the single sound manager shared by the whole process.
+ * @return Reference to the sound manager.
+ */
+SoundManager& SoundManager::getInstance() {
+    static SoundManager instance;
+    return instance;
+}
+
+/**
+ * Register an effect, decoding it the first time its asset id is seen.
+ * @param id The asset id of the sound.
+ * @param maxVoices Maximum number of copies of this effect that may play at the same time.
+ * @return Handle used to play the effect.
+ */
+int SoundManager::load(const std::string& id, unsigned maxVoices) {
+    if (maxVoices == 0) {
+        maxVoices = 1;
+    }
+    for (std::size_t i = 0; i < effects.size(); ++i) {
+        if (effects[i].id == id) {
+            effects[i].maxVoices = maxVoices;
+            return static_cast<int>(i);
+        }
+    }
+
+    // Decode once, the preloader usually did it in the background already
+    std::shared_ptr<const sf::SoundBuffer> buffer = Preloader::getInstance().loadSoundBuffer(id);
+    if (!buffer) {
+        std::cerr << "Sound " << id << " could not be loaded" << std::endl;
+    }
+    effects.push_back({id, buffer, maxVoices});
+    return static_cast<int>(effects.size() - 1);
+}
+
+/**
+ * Play an effect on a free voice, stealing the oldest voice if needed.
+ * @param effect Handle returned by load().
+ */
+void SoundManager::play(int effect) {
+    if (effect < 0 || effect >= static_cast<int>(effects.size()) || !effects[effect].buffer) {
+        return;
+    }
+
+    // Count the copies of this effect that are still playing, and remember its oldest one
+    unsigned playing = 0;
+    int oldestOwn = -1;
+    int freeVoice = -1;
+    int oldestAny = 0;
+    for (std::size_t i = 0; i < voiceCount; ++i) {
+        bool busy = voices[i].getStatus() == sf::SoundSource::Playing;
+        if (!busy) {
+            if (freeVoice < 0) {
+                freeVoice = static_cast<int>(i);
+            }
+            continue;
+        }
+        if (voiceEffect[i] == effect) {
+            ++playing;
+            if (oldestOwn < 0 || voiceStarted[i] < voiceStarted[oldestOwn]) {
+                oldestOwn = static_cast<int>(i);
+            }
+        }
+        if (voiceStarted[i] < voiceStarted[oldestAny]) {
+            oldestAny = static_cast<int>(i);
+        }
+    }
+
+    // Over the cap steals from the same effect, a full pool steals the oldest voice
+    int voice;
+    if (playing >= effects[effect].maxVoices && oldestOwn >= 0) {
+        voice = oldestOwn;
+    } else if (freeVoice >= 0) {
+        voice = freeVoice;
+    } else {
+        voice = oldestAny;
+    }
+
+    sf::Sound& sound = voices[voice];
+    if (sound.getBuffer() != effects[effect].buffer.get()) {
+        sound.setBuffer(*effects[effect].buffer);
+    }
+    sound.stop();
+    sound.play();
+    voiceEffect[voice] = effect;
+    voiceStarted[voice] = ++playCounter;
+}
+
+/**
+ * Stop every voice.
+ */
+void SoundManager::stopAll() {
+    for (auto& voice : voices) {
+        voice.stop();
+    }
+}
+
+/**
+ * Get the memory used by the decoded samples of the registered effects.
+ * @return The size of every effect buffer in bytes.
+ */
+std::size_t SoundManager::getMemoryUsage() const {
+    std::size_t bytes = 0;
+    for (const auto& effect : effects) {
+        if (effect.buffer) {
+            bytes += static_cast<std::size_t>(effect.buffer->getSampleCount()) * sizeof(sf::Int16);
+        }
+    }
+    return bytes;
+}
@@ -0,0 +1,91 @@
+/**
+ * @file soundmanager.h
+ * @brief Declaration of the SoundManager class.
+ */
+
+#ifndef FIRE_FIGHTER_SOUNDMANAGER_H
+#define FIRE_FIGHTER_SOUNDMANAGER_H
+
+#include <SFML/Audio.hpp>
+#include <array>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+#include "preloader.h"
+
+/**
+ * @class SoundManager
+ * @brief Plays sound effects through a fixed pool of voices.
+ *
+ * Every effect is decoded once and its buffer is shared by all objects that play it. Playback goes
+ * through a fixed number of sf::Sound voices created up front, so playing a sound never allocates
+ * and the game never asks SFML for more sources than it can provide. Each effect has a cap on how
+ * many of its copies may overlap; when the cap is reached, or when every voice is busy, the voice
+ * that has been playing the longest is stolen.
+ */
+class SoundManager {
+public:
+    static const std::size_t voiceCount = 16; ///< Number of voices in the pool.
+
+    /**
+     * @brief Returns the single sound manager shared by the whole process.
+     * @return Reference to the sound manager.
+     */
+    static SoundManager& getInstance();
+
+    /**
+     * @brief Registers an effect, decoding it the first time its asset id is seen.
+     *
+     * Calling load again for an id that is already registered returns the same handle and
+     * updates its voice cap.
+     *
+     * @param id The asset id of the sound (path relative to the project root).
+     * @param maxVoices Maximum number of copies of this effect that may play at the same time.
+     * @return Handle used to play the effect.
+     */
+    int load(const std::string& id, unsigned maxVoices);
+
+    /**
+     * @brief Plays an effect on a free voice, stealing the oldest voice if needed.
+     * @param effect Handle returned by load().
+     */
+    void play(int effect);
+
+    /**
+     * @brief Stops every voice.
+     */
+    void stopAll();
+
+    /**
+     * @brief Gets the memory used by the decoded samples of the registered effects.
+     * @return The size of every effect buffer in bytes.
+     */
+    std::size_t getMemoryUsage() const;
+
+private:
+    /**
+     * @brief A decoded effect and its playback limit.
+     */
+    struct Effect {
+        std::string id; ///< The asset id of the sound.
+        std::shared_ptr<const sf::SoundBuffer> buffer; ///< The decoded samples, shared by every voice.
+        unsigned maxVoices; ///< Maximum number of overlapping copies.
+    };
+
+    /**
+     * @brief Private constructor, use getInstance() to access the manager.
+     */
+    SoundManager();
+
+    SoundManager(const SoundManager&) = delete;
+    SoundManager& operator=(const SoundManager&) = delete;
+
+    std::vector<Effect> effects; ///< Registered effects, indexed by handle.
+    std::array<sf::Sound, voiceCount> voices; ///< The voice pool.
+    std::array<int, voiceCount> voiceEffect; ///< Effect last played on each voice, -1 if none.
+    std::array<unsigned long, voiceCount> voiceStarted; ///< Play counter value when each voice was started.
+    unsigned long playCounter; ///< Incremented for every played sound, used to find the oldest voice.
+};
+
+#endif //FIRE_FIGHTER_SOUNDMANAGER_H
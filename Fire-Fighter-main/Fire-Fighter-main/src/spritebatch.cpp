@@ -0,0 +1,105 @@
+#include "spritebatch.h"
+#include <cstdlib>
+
+/**
+ * Construct an empty batch.
+ */
+SpriteBatch::SpriteBatch() : culled(0) {}
+
+/**
+ * Remove every sprite from the batch, keeping the allocated storage and the visible area.
+ */
+void SpriteBatch::clear() {
+    vertices.clear();
+    runs.clear();
+    culled = 0;
+}
+
+/**
+ * Set the area sprites have to overlap to be added.
+ * @param area The visible area in world coordinates.
+ */
+void SpriteBatch::setVisibleArea(const sf::FloatRect& area) {
+    visibleArea = area;
+}
+
+/**
+ * Add a sprite with its current transform, texture rectangle and color.
+ * @param sprite The sprite to add.
+ * @return True if the sprite was added, false if it was skipped or culled.
+ */
+bool SpriteBatch::add(const sf::Sprite& sprite) {
+    const sf::Texture* texture = sprite.getTexture();
+    if (texture == nullptr) {
+        return false;
+    }
+    // The transform is cached by the sprite, so its bounds are cheap to test
+    if (visibleArea.width > 0.f && !visibleArea.intersects(sprite.getGlobalBounds())) {
+        ++culled;
+        return false;
+    }
+    if (runs.empty() || runs.back().texture != texture) {
+        runs.push_back({texture, vertices.size(), 0});
+    }
+
+    // Corners in the sprite's local space, the same ones sf::Sprite itself draws
+    const sf::IntRect& rect = sprite.getTextureRect();
+    float width = static_cast<float>(std::abs(rect.width));
+    float height = static_cast<float>(std::abs(rect.height));
+    float left = static_cast<float>(rect.left);
+    float right = left + static_cast<float>(rect.width);
+    float top = static_cast<float>(rect.top);
+    float bottom = top + static_cast<float>(rect.height);
+
+    const sf::Transform& transform = sprite.getTransform();
+    const sf::Color& color = sprite.getColor();
+    sf::Vertex topLeft(transform.transformPoint(0.f, 0.f), color, sf::Vector2f(left, top));
+    sf::Vertex topRight(transform.transformPoint(width, 0.f), color, sf::Vector2f(right, top));
+    sf::Vertex bottomRight(transform.transformPoint(width, height), color, sf::Vector2f(right, bottom));
+    sf::Vertex bottomLeft(transform.transformPoint(0.f, height), color, sf::Vector2f(left, bottom));
+
+    vertices.push_back(topLeft);
+    vertices.push_back(topRight);
+    vertices.push_back(bottomRight);
+    vertices.push_back(topLeft);
+    vertices.push_back(bottomRight);
+    vertices.push_back(bottomLeft);
+    runs.back().count += 6;
+    return true;
+}
+
+/**
+ * Get the number of sprites in the batch.
+ * @return The number of sprites added since the last clear().
+ */
+std::size_t SpriteBatch::getSpriteCount() const {
+    return vertices.size() / 6;
+}
+
+/**
+ * Get the number of draw calls drawing the batch takes.
+ * @return The number of texture runs in the batch.
+ */
+std::size_t SpriteBatch::getDrawCallCount() const {
+    return runs.size();
+}
+
+/**
+ * Get the number of sprites culled since the last clear().
+ * @return The number of sprites outside of the visible area.
+ */
+std::size_t SpriteBatch::getCulledCount() const {
+    return culled;
+}
+
+/**
+ * Draw every run of the batch with one call each.
+ * @param target The target to draw to.
+ * @param states The render states, the texture is replaced by the texture of each run.
+ */
+void SpriteBatch::draw(sf::RenderTarget& target, sf::RenderStates states) const {
+    for (const auto& run : runs) {
+        states.texture = run.texture;
+        target.draw(&vertices[run.first], run.count, sf::Triangles, states);
+    }
+}
@@ -0,0 +1,97 @@
+/**
+ * @file spritebatch.h
+ * @brief Declaration of the SpriteBatch class.
+ */
+
+#ifndef FIRE_FIGHTER_SPRITEBATCH_H
+#define FIRE_FIGHTER_SPRITEBATCH_H
+
+#include <SFML/Graphics.hpp>
+#include <vector>
+
+/**
+ * @class SpriteBatch
+ * @brief Collects many sprites into vertex batches drawn with one call per texture.
+ *
+ * Drawing a sprite costs a draw call of its own, which dominates the frame once there are hundreds
+ * of them. A batch copies the four transformed corners of every added sprite into one vertex list
+ * instead, and draws all sprites that share a texture in a single call. Consecutive sprites with the
+ * same texture share a run, so sprites from the gameplay atlas always end up in one draw call, while
+ * the order of overlapping sprites from different textures is kept.
+ *
+ * The batch is meant to be cleared and refilled every frame; its storage is kept between frames so
+ * refilling it does not allocate.
+ *
+ * A batch can be given the visible area of the frame, in which case sprites entirely outside of it
+ * are culled: they are counted but not added, so they cost neither vertices nor fill rate.
+ */
+class SpriteBatch : public sf::Drawable {
+public:
+    /**
+     * @brief Constructs an empty batch.
+     */
+    SpriteBatch();
+
+    /**
+     * @brief Removes every sprite from the batch, keeping the allocated storage and the visible area.
+     */
+    void clear();
+
+    /**
+     * @brief Sets the area sprites have to overlap to be added, usually the area the view shows.
+     * @param area The visible area in world coordinates.
+     */
+    void setVisibleArea(const sf::FloatRect& area);
+
+    /**
+     * @brief Adds a sprite with its current transform, texture rectangle and color.
+     *
+     * Sprites without a texture are skipped, sprites outside of the visible area are culled.
+     *
+     * @param sprite The sprite to add.
+     * @return True if the sprite was added, false if it was skipped or culled.
+     */
+    bool add(const sf::Sprite& sprite);
+
+    /**
+     * @brief Gets the number of sprites in the batch.
+     * @return The number of sprites added since the last clear().
+     */
+    std::size_t getSpriteCount() const;
+
+    /**
+     * @brief Gets the number of draw calls drawing the batch takes.
+     * @return The number of texture runs in the batch.
+     */
+    std::size_t getDrawCallCount() const;
+
+    /**
+     * @brief Gets the number of sprites culled since the last clear().
+     * @return The number of sprites outside of the visible area.
+     */
+    std::size_t getCulledCount() const;
+
+private:
+    /**
+     * @brief A range of consecutive vertices sharing a texture.
+     */
+    struct Run {
+        const sf::Texture* texture; ///< Texture of every sprite in the run.
+        std::size_t first; ///< Index of the first vertex of the run.
+        std::size_t count; ///< Number of vertices in the run.
+    };
+
+    /**
+     * @brief Draws every run of the batch with one call each.
+     * @param target The target to draw to.
+     * @param states The render states, the texture is replaced by the texture of each run.
+     */
+    void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
+
+    std::vector<sf::Vertex> vertices; ///< Two triangles per sprite.
+    std::vector<Run> runs; ///< Texture runs in drawing order.
+    sf::FloatRect visibleArea; ///< Area sprites have to overlap to be added, empty to add every sprite.
+    std::size_t culled; ///< Sprites culled since the last clear().
+};
+
+#endif //FIRE_FIGHTER_SPRITEBATCH_H
@@ -0,0 +1,249 @@
+#include "textlayoutcache.h"
+#include <algorithm>
+
+/**
+ * Private constructor of the TextLayoutCache.
+ */
+TextLayoutCache::TextLayoutCache() = default;
+
+/**
+ * Return the single cache shared by the whole process.
+ * @return Reference to the text layout cache.
+ */
+TextLayoutCache& TextLayoutCache::getInstance() {
+    static TextLayoutCache instance;
+    return instance;
+}
+
+/**
+ * Get the layout of a string, laying it out on first use.
+ * @param font The font of the text.
+ * @param string The string to lay out.
+ * @param characterSize The character size in pixels.
+ * @param style The sf::Text::Style flags.
+ * @return Shared handle to the layout.
+ */
+std::shared_ptr<const TextLayout> TextLayoutCache::get(const sf::Font& font, const sf::String& string, unsigned characterSize,
+                                                       sf::Uint32 style) {
+    style &= sf::Text::Bold;
+    Key key(&font, characterSize, style, string.toUtf32());
+    auto it = layouts.find(key);
+    if (it != layouts.end()) {
+        return it->second;
+    }
+
+    auto layout = std::make_shared<TextLayout>();
+    build(font, string, characterSize, style != 0, *layout);
+    layouts[key] = layout;
+    return layout;
+}
+
+/**
+ * Get the number of layouts currently held by the cache.
+ * @return The number of cached layouts.
+ */
+std::size_t TextLayoutCache::size() const {
+    return layouts.size();
+}
+
+/**
+ * Lay out a string the same way sf::Text does.
+ * @param font The font of the text.
+ * @param string The string to lay out.
+ * @param characterSize The character size in pixels.
+ * @param bold True to use the bold glyphs of the font.
+ * @param layout The layout to fill.
+ */
+void TextLayoutCache::build(const sf::Font& font, const sf::String& string, unsigned characterSize, bool bold, TextLayout& layout) {
+    layout.vertices.clear();
+    layout.bounds = sf::FloatRect();
+    if (string.isEmpty()) {
+        return;
+    }
+
+    float whitespaceWidth = font.getGlyph(L' ', characterSize, bold).advance;
+    float lineSpacing = font.getLineSpacing(characterSize);
+    float x = 0.f;
+    float y = static_cast<float>(characterSize);
+    float minX = static_cast<float>(characterSize);
+    float minY = static_cast<float>(characterSize);
+    float maxX = 0.f;
+    float maxY = 0.f;
+    sf::Uint32 previous = 0;
+
+    for (sf::Uint32 current : string) {
+        if (current == L'\r') {
+            continue;
+        }
+        x += font.getKerning(previous, current, characterSize, bold);
+        previous = current;
+
+        // Whitespace only moves the pen
+        if (current == L' ' || current == L'\n' || current == L'\t') {
+            minX = std::min(minX, x);
+            minY = std::min(minY, y);
+            if (current == L' ') {
+                x += whitespaceWidth;
+            } else if (current == L'\t') {
+                x += whitespaceWidth * 4;
+            } else {
+                y += lineSpacing;
+                x = 0.f;
+            }
+            maxX = std::max(maxX, x);
+            maxY = std::max(maxY, y);
+            continue;
+        }
+
+        // Quad of the glyph, padded by a pixel like sf::Text so filtering does not cut the edges
+        const sf::Glyph& glyph = font.getGlyph(current, characterSize, bold);
+        const float padding = 1.f;
+        float left = glyph.bounds.left - padding;
+        float top = glyph.bounds.top - padding;
+        float right = glyph.bounds.left + glyph.bounds.width + padding;
+        float bottom = glyph.bounds.top + glyph.bounds.height + padding;
+        float u1 = static_cast<float>(glyph.textureRect.left) - padding;
+        float v1 = static_cast<float>(glyph.textureRect.top) - padding;
+        float u2 = static_cast<float>(glyph.textureRect.left + glyph.textureRect.width) + padding;
+        float v2 = static_cast<float>(glyph.textureRect.top + glyph.textureRect.height) + padding;
+
+        layout.vertices.emplace_back(sf::Vector2f(x + left, y + top), sf::Color::White, sf::Vector2f(u1, v1));
+        layout.vertices.emplace_back(sf::Vector2f(x + right, y + top), sf::Color::White, sf::Vector2f(u2, v1));
+        layout.vertices.emplace_back(sf::Vector2f(x + left, y + bottom), sf::Color::White, sf::Vector2f(u1, v2));
+        layout.vertices.emplace_back(sf::Vector2f(x + left, y + bottom), sf::Color::White, sf::Vector2f(u1, v2));
+        layout.vertices.emplace_back(sf::Vector2f(x + right, y + top), sf::Color::White, sf::Vector2f(u2, v1));
+        layout.vertices.emplace_back(sf::Vector2f(x + right, y + bottom), sf::Color::White, sf::Vector2f(u2, v2));
+
+        minX = std::min(minX, x + glyph.bounds.left);
+        maxX = std::max(maxX, x + glyph.bounds.left + glyph.bounds.width);
+        minY = std::min(minY, y + glyph.bounds.top);
+        maxY = std::max(maxY, y + glyph.bounds.top + glyph.bounds.height);
+
+        x += glyph.advance;
+    }
+
+    layout.bounds = sf::FloatRect(minX, minY, maxX - minX, maxY - minY);
+}
+
+/**
+ * Construct an empty label.
+ */
+TextLabel::TextLabel() : font(nullptr), characterSize(30), style(sf::Text::Regular), fillColor(sf::Color::White) {}
+
+/**
+ * Construct a label from a string, font and character size.
+ * @param string The text to show.
+ * @param font The font of the text.
+ * @param characterSize The character size in pixels.
+ */
+TextLabel::TextLabel(const sf::String& string, const sf::Font& font, unsigned characterSize)
+        : string(string), font(&font), characterSize(characterSize), style(sf::Text::Regular), fillColor(sf::Color::White) {}
+
+/**
+ * Set the text to show.
+ * @param string The text to show.
+ */
+void TextLabel::setString(const sf::String& string) {
+    if (this->string != string) {
+        this->string = string;
+        layout.reset();
+    }
+}
+
+/**
+ * Set the font of the text.
+ * @param font The font.
+ */
+void TextLabel::setFont(const sf::Font& font) {
+    if (this->font != &font) {
+        this->font = &font;
+        layout.reset();
+    }
+}
+
+/**
+ * Set the character size.
+ * @param size The character size in pixels.
+ */
+void TextLabel::setCharacterSize(unsigned size) {
+    if (characterSize != size) {
+        characterSize = size;
+        layout.reset();
+    }
+}
+
+/**
+ * Set the style of the text.
+ * @param style The sf::Text::Style flags.
+ */
+void TextLabel::setStyle(sf::Uint32 style) {
+    if (this->style != style) {
+        this->style = style;
+        layout.reset();
+    }
+}
+
+/**
+ * Set the fill color of the text.
+ * @param color The fill color.
+ */
+void TextLabel::setFillColor(const sf::Color& color) {
+    fillColor = color;
+    for (auto& vertex : vertices) {
+        vertex.color = color;
+    }
+}
+
+/**
+ * Get the fill color of the text.
+ * @return The fill color.
+ */
+const sf::Color& TextLabel::getFillColor() const {
+    return fillColor;
+}
+
+/**
+ * Get the bounds of the text in its local coordinates.
+ * @return The local bounds.
+ */
+sf::FloatRect TextLabel::getLocalBounds() const {
+    ensureLayout();
+    return layout ? layout->bounds : sf::FloatRect();
+}
+
+/**
+ * Get the bounds of the text after its transform.
+ * @return The global bounds.
+ */
+sf::FloatRect TextLabel::getGlobalBounds() const {
+    return getTransform().transformRect(getLocalBounds());
+}
+
+/**
+ * Fetch the layout from the cache if the text changed since the last fetch.
+ */
+void TextLabel::ensureLayout() const {
+    if (layout || font == nullptr) {
+        return;
+    }
+    layout = TextLayoutCache::getInstance().get(*font, string, characterSize, style);
+    vertices = layout->vertices;
+    for (auto& vertex : vertices) {
+        vertex.color = fillColor;
+    }
+}
+
+/**
+ * Draw the glyph quads with the font texture.
+ * @param target The target to draw to.
+ * @param states The render states.
+ */
+void TextLabel::draw(sf::RenderTarget& target, sf::RenderStates states) const {
+    ensureLayout();
+    if (vertices.empty()) {
+        return;
+    }
+    states.transform *= getTransform();
+    states.texture = &font->getTexture(characterSize);
+    target.draw(vertices.data(), vertices.size(), sf::Triangles, states);
+}
@@ -0,0 +1,182 @@
+/**
+ * @file textlayoutcache.h
+ * @brief Declaration of the TextLayoutCache class, the TextLayout it stores and the TextLabel drawing it.
+ */
+
+#ifndef FIRE_FIGHTER_TEXTLAYOUTCACHE_H
+#define FIRE_FIGHTER_TEXTLAYOUTCACHE_H
+
+#include <SFML/Graphics.hpp>
+#include <map>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <vector>
+
+/**
+ * @struct TextLayout
+ * @brief A string laid out with a font, ready to be drawn.
+ *
+ * Holds two triangles per visible glyph in the local coordinates of the text, with texture
+ * coordinates into the glyph page of the font for the character size.
+ */
+struct TextLayout {
+    std::vector<sf::Vertex> vertices; ///< Glyph quads, colored white.
+    sf::FloatRect bounds; ///< Local bounds of the text, as sf::Text::getLocalBounds() would return.
+};
+
+/**
+ * @class TextLayoutCache
+ * @brief Process-wide cache of laid out strings.
+ *
+ * Laying out a string means looking up every glyph, applying kerning and measuring the result,
+ * which sf::Text does again for every text object built. The menus, the settings window and the
+ * overlays rebuild all of their texts whenever they are entered, so their layouts are cached here
+ * instead, keyed by font, character size, style and string. The font identifies the language and
+ * the character size already accounts for the resolution, so re-entering a screen or switching
+ * back to a language reuses the layouts built the first time.
+ *
+ * Fonts are owned by the FontService and live for the whole process, so keying by font is safe.
+ */
+class TextLayoutCache {
+public:
+    /**
+     * @brief Returns the single cache shared by the whole process.
+     * @return Reference to the text layout cache.
+     */
+    static TextLayoutCache& getInstance();
+
+    /**
+     * @brief Gets the layout of a string, laying it out on first use.
+     * @param font The font of the text.
+     * @param string The string to lay out.
+     * @param characterSize The character size in pixels.
+     * @param style The sf::Text::Style flags, only Bold changes the layout.
+     * @return Shared handle to the layout.
+     */
+    std::shared_ptr<const TextLayout> get(const sf::Font& font, const sf::String& string, unsigned characterSize,
+                                          sf::Uint32 style = sf::Text::Regular);
+
+    /**
+     * @brief Gets the number of layouts currently held by the cache.
+     * @return The number of cached layouts.
+     */
+    std::size_t size() const;
+
+private:
+    /**
+     * @brief Private constructor, use getInstance() to access the cache.
+     */
+    TextLayoutCache();
+
+    TextLayoutCache(const TextLayoutCache&) = delete;
+    TextLayoutCache& operator=(const TextLayoutCache&) = delete;
+
+    /**
+     * @brief Lays out a string the same way sf::Text does, without outline or decorations.
+     * @param font The font of the text.
+     * @param string The string to lay out.
+     * @param characterSize The character size in pixels.
+     * @param bold True to use the bold glyphs of the font.
+     * @param layout The layout to fill.
+     */
+    static void build(const sf::Font& font, const sf::String& string, unsigned characterSize, bool bold, TextLayout& layout);
+
+    typedef std::tuple<const sf::Font*, unsigned, sf::Uint32, std::basic_string<sf::Uint32>> Key; ///< Font, size, style and string.
+    std::map<Key, std::shared_ptr<const TextLayout>> layouts; ///< Cached layouts.
+};
+
+/**
+ * @class TextLabel
+ * @brief Drop-in replacement for sf::Text that draws a layout from the TextLayoutCache.
+ *
+ * Supports the part of the sf::Text interface the menus use. The layout is fetched lazily when the
+ * text is measured or drawn, so changing the string, font, size and style back to back only costs
+ * one lookup. Each label keeps its own copy of the vertices to apply its fill color to.
+ */
+class TextLabel : public sf::Drawable, public sf::Transformable {
+public:
+    /**
+     * @brief Constructs an empty label.
+     */
+    TextLabel();
+
+    /**
+     * @brief Constructs a label from a string, font and character size.
+     * @param string The text to show.
+     * @param font The font of the text, which must outlive the label.
+     * @param characterSize The character size in pixels.
+     */
+    TextLabel(const sf::String& string, const sf::Font& font, unsigned characterSize = 30);
+
+    /**
+     * @brief Sets the text to show.
+     * @param string The text to show.
+     */
+    void setString(const sf::String& string);
+
+    /**
+     * @brief Sets the font of the text.
+     * @param font The font, which must outlive the label.
+     */
+    void setFont(const sf::Font& font);
+
+    /**
+     * @brief Sets the character size.
+     * @param size The character size in pixels.
+     */
+    void setCharacterSize(unsigned size);
+
+    /**
+     * @brief Sets the style of the text.
+     * @param style The sf::Text::Style flags, only Bold is supported.
+     */
+    void setStyle(sf::Uint32 style);
+
+    /**
+     * @brief Sets the fill color of the text.
+     * @param color The fill color.
+     */
+    void setFillColor(const sf::Color& color);
+
+    /**
+     * @brief Gets the fill color of the text.
+     * @return The fill color.
+     */
+    const sf::Color& getFillColor() const;
+
+    /**
+     * @brief Gets the bounds of the text in its local coordinates.
+     * @return The local bounds.
+     */
+    sf::FloatRect getLocalBounds() const;
+
+    /**
+     * @brief Gets the bounds of the text after its transform.
+     * @return The global bounds.
+     */
+    sf::FloatRect getGlobalBounds() const;
+
+private:
+    /**
+     * @brief Fetches the layout from the cache if the text changed since the last fetch.
+     */
+    void ensureLayout() const;
+
+    /**
+     * @brief Draws the glyph quads with the font texture.
+     * @param target The target to draw to.
+     * @param states The render states.
+     */
+    void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
+
+    sf::String string; ///< The text to show.
+    const sf::Font* font; ///< The font of the text.
+    unsigned characterSize; ///< The character size in pixels.
+    sf::Uint32 style; ///< The sf::Text::Style flags.
+    sf::Color fillColor; ///< The fill color.
+    mutable std::shared_ptr<const TextLayout> layout; ///< The cached layout, null if stale.
+    mutable std::vector<sf::Vertex> vertices; ///< Copy of the layout's vertices in the fill color.
+};
+
+#endif //FIRE_FIGHTER_TEXTLAYOUTCACHE_H
@@ -0,0 +1,180 @@
+#include "textureatlas.h"
+#include <algorithm>
+#include <cmath>
+
+/**
+ * Point a sprite at the region.
+ * @param sprite The sprite to set the texture, texture rectangle and scale of.
+ */
+void TextureRegion::apply(sf::Sprite& sprite) const {
+    if (texture) {
+        sprite.setTexture(*texture);
+        sprite.setTextureRect(rect);
+        sprite.setScale(scale, scale);
+    }
+}
+
+/**
+ * Get the size of the image in pixels.
+ * @return The size of the image.
+ */
+sf::Vector2u TextureRegion::getSize() const {
+    return sf::Vector2u(rect.width, rect.height);
+}
+
+/**
+ * Constructor of an empty TextureAtlas.
+ * @param padding Number of transparent pixels kept between packed images.
+ */
+TextureAtlas::TextureAtlas(unsigned padding) : padding(padding) {}
+
+/**
+ * Queue an image to be packed by the next build.
+ * @param id The asset id the image is looked up by.
+ * @param image The decoded image.
+ */
+void TextureAtlas::add(const std::string& id, const sf::Image& image) {
+    pending.push_back({id, image});
+}
+
+/**
+ * Pack every queued image into atlas pages and upload them.
+ * @return True if every queued image was packed, false otherwise.
+ */
+bool TextureAtlas::build() {
+    bool packedAll = true;
+    unsigned maxSize = std::min(sf::Texture::getMaximumSize(), 4096u);
+
+    // Tallest images first keeps the shelves tight
+    std::sort(pending.begin(), pending.end(), [](const PendingImage& a, const PendingImage& b) {
+        return a.image.getSize().y > b.image.getSize().y;
+    });
+
+    // Pick a page width close to a square that fits every image
+    unsigned totalArea = 0;
+    unsigned widest = 0;
+    for (const auto& entry : pending) {
+        sf::Vector2u size = entry.image.getSize();
+        totalArea += (size.x + padding) * (size.y + padding);
+        widest = std::max(widest, size.x + padding * 2);
+    }
+    unsigned pageWidth = 64;
+    while (pageWidth < maxSize && (pageWidth * pageWidth < totalArea || pageWidth < widest)) {
+        pageWidth *= 2;
+    }
+    pageWidth = std::min(pageWidth, maxSize);
+
+    // Place images on shelves, starting a new page when the current one is full
+    struct Placement {
+        std::size_t entry;
+        std::size_t page;
+        unsigned x, y;
+    };
+    std::vector<Placement> placements;
+    std::vector<unsigned> pageHeights(1, 0);
+    unsigned x = padding, y = padding, shelfHeight = 0;
+    for (std::size_t i = 0; i < pending.size(); ++i) {
+        sf::Vector2u size = pending[i].image.getSize();
+        if (size.x + padding * 2 > pageWidth || size.y + padding * 2 > maxSize) {
+            std::cerr << "Image " << pending[i].id << " is too large for the texture atlas" << std::endl;
+            packedAll = false;
+            continue;
+        }
+        if (x + size.x + padding > pageWidth) {         // next shelf
+            y += shelfHeight + padding;
+            x = padding;
+            shelfHeight = 0;
+        }
+        if (y + size.y + padding > maxSize) {           // next page
+            pageHeights.push_back(0);
+            x = padding;
+            y = padding;
+            shelfHeight = 0;
+        }
+        placements.push_back({i, pageHeights.size() - 1, x, y});
+        x += size.x + padding;
+        shelfHeight = std::max(shelfHeight, size.y);
+        pageHeights.back() = std::max(pageHeights.back(), y + size.y + padding);
+    }
+
+    // Compose every page on the CPU and upload it once
+    std::vector<sf::Image> pageImages(pageHeights.size());
+    for (std::size_t p = 0; p < pageHeights.size(); ++p) {
+        pageImages[p].create(pageWidth, std::max(pageHeights[p], 1u), sf::Color::Transparent);
+    }
+    for (const auto& placement : placements) {
+        pageImages[placement.page].copy(pending[placement.entry].image, placement.x, placement.y);
+    }
+    std::size_t firstPage = pages.size();
+    for (const auto& pageImage : pageImages) {
+        auto page = std::make_shared<sf::Texture>();
+        if (!page->loadFromImage(pageImage)) {
+            std::cerr << "Failed to upload texture atlas page" << std::endl;
+            packedAll = false;
+        }
+        pages.push_back(page);
+    }
+    for (const auto& placement : placements) {
+        sf::Vector2u size = pending[placement.entry].image.getSize();
+        regions[pending[placement.entry].id] = {pages[firstPage + placement.page],
+                                                sf::IntRect(placement.x, placement.y, size.x, size.y)};
+    }
+
+    pending.clear();
+    return packedAll;
+}
+
+/**
+ * Look up the region of a packed image.
+ * @param id The asset id of the image.
+ * @param region Filled with the page and rectangle of the image if found.
+ * @return True if the image is part of the atlas, false otherwise.
+ */
+bool TextureAtlas::find(const std::string& id, TextureRegion& region) const {
+    auto it = regions.find(id);
+    if (it == regions.end()) {
+        return false;
+    }
+    region = it->second;
+    return true;
+}
+
+/**
+ * Get the number of pages created so far.
+ * @return The number of atlas pages.
+ */
+std::size_t TextureAtlas::getPageCount() const {
+    return pages.size();
+}
+
+/**
+ * Check if any page is still referenced by a region handed out by find().
+ * @return True if a sprite may still be drawing from the atlas, false otherwise.
+ */
+bool TextureAtlas::isInUse() const {
+    for (const auto& page : pages) {
+        // The page list and the atlas' own regions account for the expected references
+        long internal = 1;
+        for (const auto& region : regions) {
+            if (region.second.texture == page) {
+                ++internal;
+            }
+        }
+        if (page.use_count() > internal) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Get the GPU memory used by the atlas pages.
+ * @return The size of every page in bytes.
+ */
+std::size_t TextureAtlas::getMemoryUsage() const {
+    std::size_t bytes = 0;
+    for (const auto& page : pages) {
+        bytes += static_cast<std::size_t>(page->getSize().x) * page->getSize().y * 4;
+    }
+    return bytes;
+}
@@ -0,0 +1,117 @@
+/**
+ * @file textureatlas.h
+ * @brief Declaration of the TextureAtlas class and the TextureRegion handle.
+ */
+
+#ifndef FIRE_FIGHTER_TEXTUREATLAS_H
+#define FIRE_FIGHTER_TEXTUREATLAS_H
+
+#include <SFML/Graphics.hpp>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @struct TextureRegion
+ * @brief Handle to an image stored somewhere inside a texture.
+ *
+ * The texture is either an atlas page shared by many images or a standalone texture,
+ * in which case the rectangle covers the whole texture. Images sized for a pixel density other
+ * than 1 carry the scale that draws them at their size in the virtual space.
+ */
+struct TextureRegion {
+    std::shared_ptr<const sf::Texture> texture; ///< Texture containing the image.
+    sf::IntRect rect; ///< Area of the image inside the texture.
+    float scale = 1.f; ///< Size of a texel in virtual units, the inverse of the pixel density the image was sized for.
+
+    /**
+     * @brief Points a sprite at this region.
+     * @param sprite The sprite to set the texture, texture rectangle and scale of.
+     */
+    void apply(sf::Sprite& sprite) const;
+
+    /**
+     * @brief Gets the size of the image in pixels.
+     * @return The size of the image.
+     */
+    sf::Vector2u getSize() const;
+};
+
+/**
+ * @class TextureAtlas
+ * @brief Packs many small images into one or a few large textures.
+ *
+ * Images are added to the atlas and then packed into pages with shelf bin-packing. Each image
+ * is separated from its neighbours by a padding border so filtering never samples a neighbour.
+ * After building, every image is available as a TextureRegion that shares its page texture,
+ * so sprites using images from the same page can be drawn without switching textures.
+ */
+class TextureAtlas {
+public:
+    /**
+     * @brief Constructs an empty atlas.
+     * @param padding Number of transparent pixels kept between packed images.
+     */
+    explicit TextureAtlas(unsigned padding = 2);
+
+    /**
+     * @brief Queues an image to be packed by the next call to build().
+     * @param id The asset id the image is looked up by.
+     * @param image The decoded image.
+     */
+    void add(const std::string& id, const sf::Image& image);
+
+    /**
+     * @brief Packs every queued image into atlas pages and uploads them.
+     *
+     * Images are sorted by height and placed on shelves from the top left of a page. A new page
+     * is started whenever the current one would exceed the maximum texture size.
+     *
+     * @return True if every queued image was packed, false otherwise.
+     */
+    bool build();
+
+    /**
+     * @brief Looks up the region of a packed image.
+     * @param id The asset id of the image.
+     * @param region Filled with the page and rectangle of the image if found.
+     * @return True if the image is part of the atlas, false otherwise.
+     */
+    bool find(const std::string& id, TextureRegion& region) const;
+
+    /**
+     * @brief Gets the number of pages created by the last build.
+     * @return The number of atlas pages.
+     */
+    std::size_t getPageCount() const;
+
+    /**
+     * @brief Checks if any page is still referenced by a region handed out by find().
+     * @return True if a sprite may still be drawing from the atlas, false otherwise.
+     */
+    bool isInUse() const;
+
+    /**
+     * @brief Gets the GPU memory used by the atlas pages.
+     * @return The size of every page in bytes, at four bytes per pixel.
+     */
+    std::size_t getMemoryUsage() const;
+
+private:
+    /**
+     * @brief An image waiting to be packed.
+     */
+    struct PendingImage {
+        std::string id; ///< The asset id of the image.
+        sf::Image image; ///< The decoded image.
+    };
+
+    unsigned padding; ///< Transparent border kept around every image.
+    std::vector<PendingImage> pending; ///< Images queued for the next build.
+    std::vector<std::shared_ptr<sf::Texture>> pages; ///< Uploaded atlas pages.
+    std::map<std::string, TextureRegion> regions; ///< Packed images by asset id.
+};
+
+#endif //FIRE_FIGHTER_TEXTUREATLAS_H
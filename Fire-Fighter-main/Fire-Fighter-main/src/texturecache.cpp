@@ -0,0 +1,272 @@
+#include "texturecache.h"
+
+// Size of every gameplay sprite in the virtual 1280x720 space: asset id, scale of the original art
+const std::vector<TextureCache::AtlasImage> TextureCache::atlasImages = {
+        {"resource/img/fire.png", 1.f},         // enemy
+        {"resource/img/fireball.png", 0.5f},    // enemy bullet
+        {"resource/img/droplet.png", 1.2f},     // player bullet
+        {"resource/img/iceBlock.png", 1.5f},    // barrier
+        {"resource/img/life.png", 1.f},         // powerup
+        {"resource/img/0.png", 1.4f},           // health bar
+        {"resource/img/1.png", 1.4f},
+        {"resource/img/2.png", 1.4f},
+        {"resource/img/3.png", 1.4f},
+        {"resource/img/waterBoy.png", 1.f},     // player
+        {"resource/img/waterGirl.png", 1.f}};
+
+/**
+ * Private constructor of the TextureCache.
+ */
+TextureCache::TextureCache() : budget(0), useCounter(0) {}
+
+/**
+ * Return the single cache shared by the whole process.
+ * @return Reference to the texture cache.
+ */
+TextureCache& TextureCache::getInstance() {
+    static TextureCache instance;
+    return instance;
+}
+
+/**
+ * Get a handle to a texture, loading it from disk the first time the id is requested.
+ * @param id The asset id of the texture (path relative to the project root).
+ * @return Shared handle to the cached texture.
+ */
+std::shared_ptr<const sf::Texture> TextureCache::acquire(const std::string& id) {
+    auto it = textures.find(id);
+    if (it != textures.end()) {
+        it->second.lastUsed = ++useCounter;
+        return it->second.texture;
+    }
+
+    // Decode and upload the image once, failures are cached as an empty texture
+    auto texture = std::make_shared<sf::Texture>();
+    sf::Image image;
+    if (!Preloader::getInstance().loadImage(id, image) || !upload(id, image, *texture)) {
+        std::cerr << "Failed to load texture " << id << std::endl;
+    }
+    insert(id, texture);
+    return texture;
+}
+
+/**
+ * Get a handle to an image resized to the given size, loading it on first use.
+ * @param id The asset id of the texture (path relative to the project root).
+ * @param size The size of the texture, 0x0 for the size of the image on disk.
+ * @return Shared handle to the cached texture.
+ */
+std::shared_ptr<const sf::Texture> TextureCache::acquire(const std::string& id, sf::Vector2u size) {
+    if (size.x == 0 || size.y == 0) {
+        return acquire(id);
+    }
+    std::string key = id + "@" + std::to_string(size.x) + "x" + std::to_string(size.y);
+    auto it = textures.find(key);
+    if (it != textures.end()) {
+        it->second.lastUsed = ++useCounter;
+        return it->second.texture;
+    }
+
+    auto texture = std::make_shared<sf::Texture>();
+    sf::Image image;
+    if (!ImageCache::getInstance().load(id, image, size) || !upload(key, image, *texture)) {
+        std::cerr << "Failed to load texture " << id << std::endl;
+    }
+    insert(key, texture);
+    return texture;
+}
+
+/**
+ * Add a texture to the cache and evict idle textures if the budget is exceeded.
+ * @param key The cache key of the texture.
+ * @param texture The texture, still referenced by the caller so it cannot be evicted itself.
+ */
+void TextureCache::insert(const std::string& key, const std::shared_ptr<sf::Texture>& texture) {
+    CachedTexture& entry = textures[key];
+    entry.texture = texture;
+    entry.bytes = static_cast<std::size_t>(texture->getSize().x) * texture->getSize().y * 4;
+    entry.lastUsed = ++useCounter;
+    trim();
+}
+
+/**
+ * Upload an image to a texture, recording the time it took.
+ * @param key The cache key of the texture.
+ * @param image The decoded image.
+ * @param texture The texture to fill.
+ * @return True if the texture was created, false otherwise.
+ */
+bool TextureCache::upload(const std::string& key, const sf::Image& image, sf::Texture& texture) {
+    sf::Clock clock;
+    if (!texture.loadFromImage(image)) {
+        return false;
+    }
+    LoadReport::getInstance().record(LoadReport::Texture, key, clock.getElapsedTime(),
+                                     static_cast<std::size_t>(image.getSize().x) * image.getSize().y * 4, image.getSize());
+    return true;
+}
+
+/**
+ * Get the region of an image, preferring its place in the gameplay atlas.
+ * @param id The asset id of the image (path relative to the project root).
+ * @param resolution The size of the virtual space in window pixels, selecting the size the image is drawn at.
+ * @return Region of the image, scaled to its size in the virtual space.
+ */
+TextureRegion TextureCache::acquireRegion(const std::string& id, sf::Vector2u resolution) {
+    auto key = std::make_pair(resolution.x, resolution.y);
+    auto it = atlases.find(key);
+    if (it == atlases.end()) {
+        sf::Clock clock;
+        it = atlases.emplace(key, CachedAtlas()).first;
+        buildAtlas(resolution, it->second.atlas);
+        LoadReport::getInstance().record(LoadReport::Atlas, "gameplay sprites (" + std::to_string(it->second.atlas.getPageCount()) + " pages)",
+                                         clock.getElapsedTime(), it->second.atlas.getMemoryUsage(), resolution);
+    }
+    it->second.lastUsed = ++useCounter;
+    TextureRegion region;
+    if (it->second.atlas.find(id, region)) {
+        region.scale = 1280.f / static_cast<float>(resolution.x);  // the view magnifies it back by the same density
+        trim();     // only after the region holds the atlas, so a new atlas is never the one evicted
+        return region;
+    }
+
+    // Not an atlas image, use the whole standalone texture
+    region.texture = acquire(id);
+    region.rect = sf::IntRect(0, 0, region.texture->getSize().x, region.texture->getSize().y);
+    return region;
+}
+
+/**
+ * Get the scale an atlas image is drawn at for a resolution.
+ * @param image The atlas image.
+ * @param resolution The resolution of the game.
+ * @return Horizontal and vertical scale of the image.
+ */
+sf::Vector2f TextureCache::getVariantScale(const AtlasImage& image, sf::Vector2u resolution) {
+    return {image.scale * ((float)resolution.x / 1280.f), image.scale * ((float)resolution.y / 720.f)};
+}
+
+/**
+ * Decode every gameplay image, resize it for the resolution and pack it into an atlas.
+ * @param resolution The resolution of the game.
+ * @param atlas The atlas to fill.
+ */
+void TextureCache::buildAtlas(sf::Vector2u resolution, TextureAtlas& atlas) {
+    for (const auto& entry : atlasImages) {
+        sf::Image image;
+        if (!Preloader::getInstance().loadImage(entry.id, image)) {
+            std::cerr << "Failed to load texture " << entry.id << std::endl;
+            continue;
+        }
+
+        // Resize on the CPU once, so the GPU samples the sprite 1:1 on every draw
+        sf::Vector2f scale = getVariantScale(entry, resolution);
+        sf::Vector2u size(std::max(1u, static_cast<unsigned>(image.getSize().x * scale.x + 0.5f)),
+                          std::max(1u, static_cast<unsigned>(image.getSize().y * scale.y + 0.5f)));
+        if (size != image.getSize()) {
+            sf::Image resized;
+            ImageCache::resample(image, size, resized, false);
+            atlas.add(entry.id, resized);
+        } else {
+            atlas.add(entry.id, image);
+        }
+    }
+    if (!atlas.build()) {
+        std::cerr << "Some images could not be packed into the texture atlas" << std::endl;
+    }
+}
+
+/**
+ * Release every texture and atlas that is only referenced by the cache itself.
+ */
+void TextureCache::purge() {
+    for (auto it = textures.begin(); it != textures.end();) {
+        if (it->second.texture.use_count() == 1) {
+            it = textures.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    for (auto it = atlases.begin(); it != atlases.end();) {
+        if (!it->second.atlas.isInUse()) {
+            it = atlases.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+/**
+ * Get the number of textures currently held by the cache.
+ * @return The number of cached textures.
+ */
+std::size_t TextureCache::size() const {
+    return textures.size();
+}
+
+/**
+ * Get the GPU memory used by the cached textures and atlas pages.
+ * @return The size of every cached texture in bytes.
+ */
+std::size_t TextureCache::getMemoryUsage() const {
+    std::size_t bytes = 0;
+    for (const auto& texture : textures) {
+        bytes += texture.second.bytes;
+    }
+    for (const auto& atlas : atlases) {
+        bytes += atlas.second.atlas.getMemoryUsage();
+    }
+    return bytes;
+}
+
+/**
+ * Set the memory budget and evict idle textures until the cache fits in it.
+ * @param bytes The budget in bytes, 0 for no budget.
+ */
+void TextureCache::setMemoryBudget(std::size_t bytes) {
+    budget = bytes;
+    trim();
+}
+
+/**
+ * Get the memory budget.
+ * @return The budget in bytes, 0 if there is none.
+ */
+std::size_t TextureCache::getMemoryBudget() const {
+    return budget;
+}
+
+/**
+ * Evict the least recently used idle textures and atlases until the cache fits in the budget.
+ */
+void TextureCache::trim() {
+    if (budget == 0) {
+        return;
+    }
+    std::size_t usage = getMemoryUsage();
+    while (usage > budget) {
+        // Textures still held by sprites are pinned, evicting them would free nothing
+        auto texture = textures.end();
+        for (auto it = textures.begin(); it != textures.end(); ++it) {
+            if (it->second.texture.use_count() == 1 && (texture == textures.end() || it->second.lastUsed < texture->second.lastUsed)) {
+                texture = it;
+            }
+        }
+        auto atlas = atlases.end();
+        for (auto it = atlases.begin(); it != atlases.end(); ++it) {
+            if (!it->second.atlas.isInUse() && (atlas == atlases.end() || it->second.lastUsed < atlas->second.lastUsed)) {
+                atlas = it;
+            }
+        }
+
+        if (atlas != atlases.end() && (texture == textures.end() || atlas->second.lastUsed < texture->second.lastUsed)) {
+            usage -= atlas->second.atlas.getMemoryUsage();
+            atlases.erase(atlas);
+        } else if (texture != textures.end()) {
+            usage -= texture->second.bytes;
+            textures.erase(texture);
+        } else {
+            return;     // everything left is in use, the cache stays over budget until it is released
+        }
+    }
+}
@@ -0,0 +1,198 @@
+/**
+ * @file texturecache.h
+ * @brief Declaration of the TextureCache class.
+ */
+
+#ifndef FIRE_FIGHTER_TEXTURECACHE_H
+#define FIRE_FIGHTER_TEXTURECACHE_H
+
+#include <SFML/Graphics.hpp>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include "textureatlas.h"
+#include "preloader.h"
+#include "imagecache.h"
+#include "loadreport.h"
+
+/**
+ * @class TextureCache
+ * @brief Process-wide cache of textures shared between game objects.
+ *
+ * Textures are keyed by asset id, which is the path of the image relative to the project root
+ * (for example "resource/img/fire.png"). Images are taken from the Preloader when it has already
+ * decoded them in the background. Each image is decoded and uploaded the first time it is
+ * acquired and every later request for the same id returns a handle to that same texture.
+ * Handles are reference counted, so sprites that point at a cached texture stay valid no matter
+ * how often the object owning the sprite is copied.
+ *
+ * The small gameplay sprites are additionally packed into a TextureAtlas the first time a region
+ * is requested, so entities, bullets, barriers, the powerup and the health bar all sample the
+ * same texture and can be drawn back to back without texture switches. There is one atlas per
+ * resolution the virtual space is shown at, holding every sprite already resized to its size on
+ * screen at that resolution, and each region scales its sprite back to the virtual space, so the
+ * view draws the sprites at 1:1 scale. The sizes are listed in a single table in texturecache.cpp
+ * instead of being worked out by every game object.
+ *
+ * An optional memory budget bounds the textures the cache keeps around. Whenever the cache grows
+ * past it, the least recently used textures and atlases that no sprite references anymore are
+ * released, and acquiring them again later simply reloads them (from the ImageCache, so without
+ * decoding). Textures that are still referenced are pinned: releasing them would free nothing
+ * while a sprite is drawing from them, so the cache can temporarily exceed the budget.
+ */
+class TextureCache {
+public:
+    /**
+     * @brief Returns the single cache shared by the whole process.
+     * @return Reference to the texture cache.
+     */
+    static TextureCache& getInstance();
+
+    /**
+     * @brief Gets a handle to the texture with the given asset id, loading it on first use.
+     *
+     * If the image cannot be loaded an error message is printed and an empty texture is cached
+     * under the id, so a missing file is reported once instead of on every request.
+     *
+     * @param id The asset id of the texture (path relative to the project root).
+     * @return Shared handle to the cached texture.
+     */
+    std::shared_ptr<const sf::Texture> acquire(const std::string& id);
+
+    /**
+     * @brief Gets a handle to an image resized to the given size, loading it on first use.
+     *
+     * Used for full screen images such as backgrounds, which are resized once on the CPU (and
+     * kept in the ImageCache) instead of being stretched by the GPU every frame.
+     *
+     * @param id The asset id of the texture (path relative to the project root).
+     * @param size The size of the texture, 0x0 for the size of the image on disk.
+     * @return Shared handle to the cached texture.
+     */
+    std::shared_ptr<const sf::Texture> acquire(const std::string& id, sf::Vector2u size);
+
+    /**
+     * @brief Gets the region of an image, preferring its place in the gameplay atlas.
+     *
+     * The atlas for the resolution is built on the first call with that resolution. Images that
+     * are not part of the atlas fall back to a standalone texture from acquire() with a rectangle
+     * covering the whole texture, at the size of the image on disk.
+     *
+     * @param id The asset id of the image (path relative to the project root).
+     * @param resolution The size of the virtual space in window pixels, see VirtualView::getResolution().
+     * @return Region of the image, scaled to its size in the virtual space.
+     */
+    TextureRegion acquireRegion(const std::string& id, sf::Vector2u resolution);
+
+    /**
+     * @brief Releases every cached texture and atlas that is no longer referenced outside of the cache.
+     */
+    void purge();
+
+    /**
+     * @brief Gets the number of textures currently held by the cache.
+     * @return The number of cached textures.
+     */
+    std::size_t size() const;
+
+    /**
+     * @brief Gets the GPU memory used by the cached textures and atlas pages.
+     * @return The size of every cached texture in bytes, at four bytes per pixel.
+     */
+    std::size_t getMemoryUsage() const;
+
+    /**
+     * @brief Sets the memory budget and evicts idle textures until the cache fits in it.
+     * @param bytes The budget in bytes, 0 for no budget.
+     */
+    void setMemoryBudget(std::size_t bytes);
+
+    /**
+     * @brief Gets the memory budget.
+     * @return The budget in bytes, 0 if there is none.
+     */
+    std::size_t getMemoryBudget() const;
+
+private:
+    /**
+     * @brief Private constructor, use getInstance() to access the cache.
+     */
+    TextureCache();
+
+    TextureCache(const TextureCache&) = delete;
+    TextureCache& operator=(const TextureCache&) = delete;
+
+    /**
+     * @brief A gameplay sprite and the size it is drawn at.
+     *
+     * The original art is drawn at scale times its size at 1280x720, the virtual resolution the
+     * gameplay runs in, and proportionally larger or smaller at other resolutions.
+     */
+    struct AtlasImage {
+        std::string id; ///< The asset id of the image.
+        float scale; ///< Scale of the image at 1280x720.
+    };
+
+    /**
+     * @brief A cached texture and when it was last acquired.
+     */
+    struct CachedTexture {
+        std::shared_ptr<sf::Texture> texture; ///< The texture.
+        std::size_t bytes; ///< Approximate memory used by the texture.
+        unsigned long lastUsed; ///< Use counter value when the texture was last acquired.
+    };
+
+    /**
+     * @brief A cached atlas and when it was last acquired from.
+     */
+    struct CachedAtlas {
+        TextureAtlas atlas; ///< The atlas.
+        unsigned long lastUsed = 0; ///< Use counter value when a region was last acquired.
+    };
+
+    /**
+     * @brief Gets the scale an atlas image is drawn at for a resolution.
+     * @param image The atlas image.
+     * @param resolution The resolution of the game.
+     * @return Horizontal and vertical scale of the image.
+     */
+    static sf::Vector2f getVariantScale(const AtlasImage& image, sf::Vector2u resolution);
+
+    /**
+     * @brief Adds a texture to the cache and evicts idle textures if the budget is exceeded.
+     * @param key The cache key of the texture.
+     * @param texture The texture, which must still be referenced by the caller.
+     */
+    void insert(const std::string& key, const std::shared_ptr<sf::Texture>& texture);
+
+    /**
+     * @brief Evicts the least recently used idle textures and atlases until the cache fits in the budget.
+     */
+    void trim();
+
+    /**
+     * @brief Uploads an image to a texture and records the upload in the LoadReport.
+     * @param key The cache key of the texture.
+     * @param image The decoded image.
+     * @param texture The texture to fill.
+     * @return True if the texture was created, false otherwise.
+     */
+    static bool upload(const std::string& key, const sf::Image& image, sf::Texture& texture);
+
+    /**
+     * @brief Decodes every gameplay image, resizes it for the resolution and packs it into an atlas.
+     * @param resolution The resolution of the game.
+     * @param atlas The atlas to fill.
+     */
+    void buildAtlas(sf::Vector2u resolution, TextureAtlas& atlas);
+
+    std::map<std::string, CachedTexture> textures; ///< Cached textures by asset id.
+    std::map<std::pair<unsigned, unsigned>, CachedAtlas> atlases; ///< Atlas of pre-sized gameplay sprites by resolution.
+    std::size_t budget; ///< Memory budget in bytes, 0 for none.
+    unsigned long useCounter; ///< Incremented on every acquire, used to find the least recently used entry.
+    static const std::vector<AtlasImage> atlasImages; ///< Gameplay sprites packed into the atlases.
+};
+
+#endif //FIRE_FIGHTER_TEXTURECACHE_H
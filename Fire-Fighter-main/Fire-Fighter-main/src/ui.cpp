@@ -4,6 +4,7 @@
 Ui::Ui() {
     sf::VideoMode fullScreenMode = sf::VideoMode::getDesktopMode();
     window.create((options.isFullScreen()) ? fullScreenMode : sf::VideoMode(options.getResolution()[0], options.getResolution()[1]), "Fire Fighter", (options.isFullScreen() || options.getResolution()[0] >= fullScreenMode.width) ? sf::Style::Fullscreen : sf::Style::Default);
+    MusicService::getInstance().prefetch("music/EyjafjallaDream.mp3");         // open the menu music in the background
     _init();
 }
 
@@ -51,35 +52,37 @@ void Ui::displayMenu() {
 
     // Create new game button text
     sf::String newGameString = options.getLanguage()[0];
-    sf::Text newGameText(newGameString, font, options.widthScaling(26));
+    TextLabel newGameText(newGameString, *font, options.widthScaling(26));
     newGameText.setFillColor(sf::Color(235, 70, 60));
     newGameText.setPosition(newGameButton.getPosition().x + (newGameText.getLocalBounds().width / 4), newGameButton.getPosition().y + newGameText.getLocalBounds().height * 1.5);
     // Create settings button text
     sf::String settingsString = options.getLanguage()[1];
-    sf::Text settingsText(settingsString, font, options.widthScaling(26));
+    TextLabel settingsText(settingsString, *font, options.widthScaling(26));
     settingsText.setFillColor(sf::Color(235, 70, 60));
     settingsText.setPosition(settingsbutton.getPosition().x + (settingsText.getLocalBounds().width / 4), settingsbutton.getPosition().y + settingsText.getLocalBounds().height * 1.5);
     // Create quit button text
     sf::String quitString = options.getLanguage()[2];
-    sf::Text quitText(quitString, font, options.widthScaling(26));
+    TextLabel quitText(quitString, *font, options.widthScaling(26));
     quitText.setFillColor(sf::Color(235, 70, 60));
     quitText.setPosition(quitButton.getPosition().x + (quitText.getLocalBounds().width), settingsbutton.getPosition().y + settingsText.getLocalBounds().height * 1.5);
 
     // set up background image
-    sf::Sprite background(backgroundImage);
-    background.setTexture(backgroundImage);
+    sf::Sprite background(*backgroundImage);
+    background.setTexture(*backgroundImage);
     background.setScale(window.getSize().x / background.getLocalBounds().width, window.getSize().y / background.getLocalBounds().height);
 
-    if (options.toggleMusic()) music.play();
+    if (!options.toggleMusic()) MusicService::getInstance().stop(sf::seconds(0.5f));         // the stream stays open across menu rebuilds,
+    else MusicService::getInstance().play("music/EyjafjallaDream.mp3");                     // and keeps playing if it already is
 
     bool startGameFlag = false;
     bool openSettings = false;
     bool exitFlag = false;
 
-    // The UI window loop starts here
+    // The UI window loop starts here, it only redraws after input since nothing else changes
+    MenuEventQueue events(window);
     while (1) {
         sf::Event event;
-        while (window.pollEvent(event)) {
+        while (events.poll(event)) {
             // check if user has closed the window
             if (event.type == sf::Event::Closed) {
                 window.close();
@@ -107,8 +110,9 @@ void Ui::displayMenu() {
         }
         // checks if new game button was pressed or not
         if (startGameFlag) {
-            if (options.toggleMusic()) music.pause();
+            if (options.toggleMusic()) MusicService::getInstance().prefetch("music/rglk2theme2distort.mp3"); // the menu music fades into it once the game starts
             window.close();
+            backgroundImage.reset();    // let the next scene evict the menu background
 
             startGame = new Game(&options);
             startGame->gameLoop();
@@ -116,12 +120,13 @@ void Ui::displayMenu() {
             startGame = nullptr;
 
             startGameFlag = false;
-            if (options.toggleMusic()) music.play();
             exitFlag = true;    // set to true we can exit the loop and create a new window for UI
             break;
         }
         if (openSettings) {
             window.close();
+            backgroundImage.reset();    // let the next scene evict the menu background
+            SceneManager::getInstance().enterScene(Scene::Settings, options.getVector());
             options.openSettings();
             // when exited settings
             exitFlag = true;    // set to true to exit loop and create a new UI window reloaded with new settings applied weather or not any changes were applied in settings
@@ -153,6 +158,8 @@ void Ui::displayMenu() {
         window.draw(settingsText);
         window.draw(quitText);
         window.display();
+        pacer.wait();       // keep bursts of input from redrawing faster than the frame rate
+        events.wait();      // sleep until the next input
     }// end of while loop
 
     if (exitFlag) {     // if returning from settings or playing a new game, then reload UI
@@ -169,17 +176,18 @@ void Ui::displayMenu() {
  * */
 void Ui::_init() {
     sf::Image icon = options.getIcon();                                                             // Load icon image
-    window.setFramerateLimit(60);                                                              // set frame rate
+    pacer.configure(window, options.getFrameRate(), options.isVsync());                            // pace frames at the configured rate
     window.setIcon(icon.getSize().x, icon.getSize().y, icon.getPixelsPtr());     // Set the window icon
     options.userScreenInfo(window.getSize().x, window.getSize().y);                                 // send user screen info to settings
-    font = options.getFont();                                                                       // Set the font
-    if (!backgroundImage.loadFromFile("../../resource/img/menu_background.jpg")) {          // load background image for main menu
+    TextureCache::getInstance().setMemoryBudget(options.getTextureBudget());                        // bound the textures kept around
+    Preloader::getInstance().start();                                                               // decode gameplay assets while the menu is shown
+    options.prewarmFont();                                                                          // rasterize the glyphs of the language up front
+    font = &options.getFont();                                                                      // Set the shared font
+    SceneManager::getInstance().enterScene(Scene::Menu, window.getSize());                          // keep the menu assets, evict the rest
+    backgroundImage = TextureCache::getInstance().acquire("resource/img/menu_background.jpg", window.getSize()); // background pre-scaled to the window
+    if (backgroundImage->getSize().x == 0) {
         std::cerr << "Failed to load background image!" << std::endl;
     }
-    if (!music.openFromFile("../../music/EyjafjallaDream.mp3")) {                           // set music for the main menu
-        std::cerr << "Failed to load music" << std::endl;
-    }
-    music.setLoop(true);                                                                            // enable music to loop
 }
 
 /** help create the button shapes on screen */
@@ -6,15 +6,21 @@
 #include <iostream>
 #include "settings.h"
 #include "game.h"
+#include "preloader.h"
+#include "scenemanager.h"
+#include "musicservice.h"
+#include "textlayoutcache.h"
+#include "menueventqueue.h"
+#include "framepacer.h"
 
 class Ui {
 private:
     Game* startGame;
     sf::RenderWindow window;
+    FramePacer pacer;
     Settings options;
-    sf::Texture backgroundImage;
-    sf::Font font;
-    sf::Music music;
+    std::shared_ptr<const sf::Texture> backgroundImage;
+    const sf::Font* font;
 public:
     Ui();
     ~Ui();
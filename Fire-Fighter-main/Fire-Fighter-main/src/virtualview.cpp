@@ -0,0 +1,87 @@
+#include "virtualview.h"
+#include <algorithm>
+#include <cmath>
+
+float VirtualView::pixelDensity = 1.f;
+
+/**
+ * Get the size of the virtual space.
+ * @return The size of the virtual space in units.
+ */
+sf::Vector2f VirtualView::getSize() {
+    return {static_cast<float>(width), static_cast<float>(height)};
+}
+
+/**
+ * Get the size of the virtual space in window pixels.
+ * @return The size of the virtual space at the current pixel density.
+ */
+sf::Vector2u VirtualView::getResolution() {
+    return {std::max(1u, static_cast<unsigned>(std::lround(width * pixelDensity))),
+            std::max(1u, static_cast<unsigned>(std::lround(height * pixelDensity)))};
+}
+
+/**
+ * Set the number of window pixels per virtual unit the gameplay is shown at.
+ * @param density The number of window pixels per virtual unit.
+ */
+void VirtualView::setPixelDensity(float density) {
+    pixelDensity = std::max(std::round(density * 4.f) / 4.f, 0.25f);
+}
+
+/**
+ * Get the number of window pixels per virtual unit the gameplay is shown at.
+ * @return The density set by setPixelDensity() rounded to a quarter, 1 before it is called.
+ */
+float VirtualView::getPixelDensity() {
+    return pixelDensity;
+}
+
+/**
+ * Get the number of window pixels per virtual unit.
+ * @param windowSize Size of the window in pixels.
+ * @return The scale the virtual space is shown at.
+ */
+float VirtualView::getDensity(sf::Vector2u windowSize) {
+    return std::min(static_cast<float>(windowSize.x) / width, static_cast<float>(windowSize.y) / height);
+}
+
+/**
+ * Create the view showing the whole virtual space in a window, letterboxed to keep its aspect ratio.
+ * @param windowSize Size of the window in pixels.
+ * @return The view to draw the gameplay with.
+ */
+sf::View VirtualView::letterbox(sf::Vector2u windowSize) {
+    sf::View view(sf::FloatRect(0.f, 0.f, static_cast<float>(width), static_cast<float>(height)));
+    if (windowSize.x == 0 || windowSize.y == 0) {
+        return view;    // minimized
+    }
+
+    // Fraction of the window covered by the virtual space, centered between the bars
+    float density = getDensity(windowSize);
+    float viewportWidth = width * density / windowSize.x;
+    float viewportHeight = height * density / windowSize.y;
+    view.setViewport(sf::FloatRect((1.f - viewportWidth) / 2.f, (1.f - viewportHeight) / 2.f, viewportWidth, viewportHeight));
+    return view;
+}
+
+/**
+ * Get the rectangle of the world a view shows.
+ * @param view The view, without rotation.
+ * @return The visible area in world coordinates.
+ */
+sf::FloatRect VirtualView::getVisibleArea(const sf::View& view) {
+    return sf::FloatRect(view.getCenter() - view.getSize() / 2.f, view.getSize());
+}
+
+/**
+ * Set the size of a text in virtual units, rasterized at the pixel size it is shown at.
+ * @param text The text to size.
+ * @param characterSize The character size in virtual units.
+ * @param density The number of window pixels per virtual unit.
+ */
+void VirtualView::setCharacterSize(sf::Text& text, float characterSize, float density) {
+    density = std::max(density, 0.01f);
+    text.setCharacterSize(std::max(1u, static_cast<unsigned>(std::lround(characterSize * density))));
+    text.setScale(1.f / density, 1.f / density);
+}
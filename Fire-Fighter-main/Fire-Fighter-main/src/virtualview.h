@@ -0,0 +1,94 @@
+/**
+ * @file virtualview.h
+ * @brief Declaration of the VirtualView class.
+ */
+
+#ifndef FIRE_FIGHTER_VIRTUALVIEW_H
+#define FIRE_FIGHTER_VIRTUALVIEW_H
+
+#include <SFML/Graphics.hpp>
+
+/**
+ * @class VirtualView
+ * @brief The fixed coordinate space the gameplay runs in, and its mapping onto a window.
+ *
+ * Every game object is placed, sized and moved in a virtual space of 1280x720 units, whatever the
+ * size of the window. The window shows that space through an sf::View that scales it up or down as
+ * a whole, keeping its aspect ratio and filling the rest of the window with black bars. So the
+ * simulation never scales anything for the resolution, any window size works, and switching the
+ * resolution only means replacing the view.
+ *
+ * Nothing is rasterized at the virtual size though, it would be blurry when magnified. The gameplay
+ * atlas is built for getResolution(), the size the virtual space covers in window pixels, and its
+ * regions scale the sprites back down by the pixel density, so the view draws every texel to one
+ * pixel. setCharacterSize() does the same for text, rasterizing it at the size it ends up at on screen.
+ */
+class VirtualView {
+public:
+    /**
+     * @brief Gets the size of the virtual space.
+     * @return The size of the virtual space in units.
+     */
+    static sf::Vector2f getSize();
+
+    /**
+     * @brief Gets the size of the virtual space in window pixels, the resolution to acquire sprites for.
+     * @return The size of the virtual space at the current pixel density.
+     */
+    static sf::Vector2u getResolution();
+
+    /**
+     * @brief Sets the number of window pixels per virtual unit the gameplay is shown at.
+     *
+     * The density is rounded to a quarter, so resizing the window only needs a new atlas when the
+     * size changes noticeably, and the common resolutions (720p, 900p, 1080p, 1440p, 4K) still get
+     * their exact density. Sprites acquired afterwards come from the atlas for the new density,
+     * sprites acquired before keep drawing at the right size from the old one until they are
+     * acquired again.
+     *
+     * @param density The number of window pixels per virtual unit.
+     */
+    static void setPixelDensity(float density);
+
+    /**
+     * @brief Gets the number of window pixels per virtual unit the gameplay is shown at.
+     * @return The density set by setPixelDensity() rounded to a quarter, 1 before it is called.
+     */
+    static float getPixelDensity();
+
+    /**
+     * @brief Gets the number of window pixels per virtual unit.
+     * @param windowSize Size of the window in pixels.
+     * @return The scale the virtual space is shown at.
+     */
+    static float getDensity(sf::Vector2u windowSize);
+
+    /**
+     * @brief Creates the view showing the whole virtual space in a window, letterboxed to keep its aspect ratio.
+     * @param windowSize Size of the window in pixels.
+     * @return The view to draw the gameplay with.
+     */
+    static sf::View letterbox(sf::Vector2u windowSize);
+
+    /**
+     * @brief Gets the rectangle of the world a view shows, to skip drawing what is outside of it.
+     * @param view The view, without rotation.
+     * @return The visible area in world coordinates.
+     */
+    static sf::FloatRect getVisibleArea(const sf::View& view);
+
+    /**
+     * @brief Sets the size of a text in virtual units, keeping it sharp at the pixel density of the window.
+     * @param text The text to size.
+     * @param characterSize The character size in virtual units.
+     * @param density The number of window pixels per virtual unit.
+     */
+    static void setCharacterSize(sf::Text& text, float characterSize, float density);
+
+private:
+    static const unsigned width = 1280; ///< Width of the virtual space.
+    static const unsigned height = 720; ///< Height of the virtual space.
+    static float pixelDensity; ///< Number of window pixels per virtual unit of the game window.
+};
+
+#endif //FIRE_FIGHTER_VIRTUALVIEW_H
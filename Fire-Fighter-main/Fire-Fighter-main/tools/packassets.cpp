@@ -0,0 +1,82 @@
+/**
+ * @file packassets.cpp
+ * @brief Build step that writes every game asset into a single asset pack file.
+ *
+ * Usage: AssetPacker <output file> <project root> <asset id>...
+ *
+ * Each asset id is a path relative to the project root. The pack starts with a PackHeader and the
+ * PackEntry index, followed by the contents of every asset aligned to AssetPack::alignment so the
+ * game can map the file and hand each blob straight to SFML.
+ */
+
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "../src/assetpack.h"
+
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        std::cerr << "Usage: " << argv[0] << " <output file> <project root> <asset id>..." << std::endl;
+        return 1;
+    }
+    std::string outputPath = argv[1];
+    std::string rootPath = std::string(argv[2]) + "/";
+    std::vector<std::string> ids(argv + 3, argv + argc);
+
+    // Read every asset into memory
+    std::vector<std::vector<char>> contents;
+    for (const auto& id : ids) {
+        if (id.size() >= sizeof(PackEntry::name)) {
+            std::cerr << "Asset id is too long: " << id << std::endl;
+            return 1;
+        }
+        std::ifstream file(rootPath + id, std::ios::binary);
+        if (!file.is_open()) {
+            std::cerr << "Failed to open asset " << rootPath + id << std::endl;
+            return 1;
+        }
+        contents.emplace_back(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+
+    // Lay out the index and the aligned blobs
+    PackHeader header{};
+    std::memcpy(header.magic, AssetPack::magic, sizeof(header.magic));
+    header.version = AssetPack::version;
+    header.entryCount = static_cast<std::uint32_t>(ids.size());
+    header.alignment = AssetPack::alignment;
+
+    std::vector<PackEntry> index(ids.size());
+    std::uint64_t offset = sizeof(PackHeader) + sizeof(PackEntry) * ids.size();
+    for (std::size_t i = 0; i < ids.size(); ++i) {
+        offset = (offset + AssetPack::alignment - 1) / AssetPack::alignment * AssetPack::alignment;
+        std::memset(index[i].name, 0, sizeof(index[i].name));
+        std::memcpy(index[i].name, ids[i].c_str(), ids[i].size());
+        index[i].offset = offset;
+        index[i].size = contents[i].size();
+        offset += contents[i].size();
+    }
+
+    // Write header, index and blobs with zero padding between them
+    std::ofstream output(outputPath, std::ios::binary | std::ios::trunc);
+    if (!output.is_open()) {
+        std::cerr << "Failed to open " << outputPath << " for writing" << std::endl;
+        return 1;
+    }
+    output.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    output.write(reinterpret_cast<const char*>(index.data()), static_cast<std::streamsize>(sizeof(PackEntry) * index.size()));
+    std::uint64_t position = sizeof(PackHeader) + sizeof(PackEntry) * index.size();
+    const std::vector<char> padding(AssetPack::alignment, 0);
+    for (std::size_t i = 0; i < ids.size(); ++i) {
+        output.write(padding.data(), static_cast<std::streamsize>(index[i].offset - position));
+        output.write(contents[i].data(), static_cast<std::streamsize>(contents[i].size()));
+        position = index[i].offset + contents[i].size();
+    }
+    if (!output) {
+        std::cerr << "Failed to write " << outputPath << std::endl;
+        return 1;
+    }
+    std::cout << "Packed " << ids.size() << " assets into " << outputPath << " (" << position << " bytes)" << std::endl;
+    return 0;
+}